@@ -0,0 +1,202 @@
+/*!
+ * @brief Micro-benchmarks of the hot paths of the coupling adapter.
+ *
+ * The adapter is linked against a stand-in for preCICE's SolverInterface
+ * (mocksolverinterface.cc), so the benchmarks run without a coupling
+ * partner and only measure the adapter's own overhead. The benchmarks that
+ * depend on the interface size run over sizes from 10^2 to 10^6 faces.
+ */
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "dumux-precice/couplingadapter.hh"
+#include "dumux-precice/dumuxpreciceindexmapper.hh"
+
+namespace
+{
+using Dumux::Precice::CouplingAdapter;
+using Dumux::Precice::IndexMappingType;
+using IndexMapper = Dumux::Precice::Internal::DumuxPreciceIndexMapper<int>;
+
+/*!
+ * @brief Creates DuMuX face identifiers of a coupling interface.
+ *
+ * Coupled faces are a shuffled subset of all faces of the grid, as
+ * produced when iterating over the elements along the interface.
+ *
+ * @param[in] numFaces Number of coupled faces.
+ * @return std::vector<int> Face identifiers.
+ */
+std::vector<int> makeFaceIDs(const int numFaces)
+{
+    std::vector<int> faceIDs(numFaces);
+    for (int i = 0; i < numFaces; ++i)
+        faceIDs[i] = 4 * i + 1;
+    std::shuffle(faceIDs.begin(), faceIDs.end(), std::mt19937(42));
+    return faceIDs;
+}
+
+/*!
+ * @brief Creates preCICE vertex identifiers, numbered consecutively.
+ *
+ * @param[in] numFaces Number of coupled faces.
+ * @return std::vector<int> Vertex identifiers.
+ */
+std::vector<int> makeVertexIDs(const int numFaces)
+{
+    std::vector<int> vertexIDs(numFaces);
+    std::iota(vertexIDs.begin(), vertexIDs.end(), 0);
+    return vertexIDs;
+}
+
+/*!
+ * @brief Coupling adapter with one mesh and one scalar quantity.
+ *
+ * The adapter is set up in the order of the drivers: the quantities are
+ * announced after initialize.
+ */
+struct AdapterFixture {
+    explicit AdapterFixture(const int numFaces)
+        : faceIDs(makeFaceIDs(numFaces))
+    {
+        adapter.announceSolver("Benchmark", "precice-config.xml", 0, 1);
+        std::vector<double> coordinates(
+            std::size_t(numFaces) * adapter.getDimensions(), 0.);
+        const auto meshIndex =
+            adapter.setMesh("BenchmarkMesh", numFaces, coordinates);
+        adapter.createIndexMapping(meshIndex, faceIDs);
+        adapter.initialize();
+        dataID = adapter.announceScalarQuantity(meshIndex, "Pressure");
+    }
+
+    CouplingAdapter adapter;
+    std::vector<int> faceIDs;
+    size_t dataID;
+};
+
+void indexMapperCreateMapping(benchmark::State &state,
+                              const IndexMappingType mappingType)
+{
+    const auto numFaces = int(state.range(0));
+    const auto faceIDs = makeFaceIDs(numFaces);
+    const auto vertexIDs = makeVertexIDs(numFaces);
+    IndexMapper mapper;
+    for (auto _ : state) {
+        mapper.createMapping(faceIDs, vertexIDs, mappingType);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * numFaces);
+}
+
+void indexMapperLookup(benchmark::State &state,
+                       const IndexMappingType mappingType)
+{
+    const auto numFaces = int(state.range(0));
+    const auto faceIDs = makeFaceIDs(numFaces);
+    IndexMapper mapper;
+    mapper.createMapping(faceIDs, makeVertexIDs(numFaces), mappingType);
+    for (auto _ : state) {
+        for (const auto faceID : faceIDs)
+            benchmark::DoNotOptimize(mapper.getPreciceId(faceID));
+    }
+    state.SetItemsProcessed(state.iterations() * numFaces);
+}
+
+void writeScalarQuantityOnFace(benchmark::State &state)
+{
+    AdapterFixture fixture(int(state.range(0)));
+    for (auto _ : state) {
+        for (const auto faceID : fixture.faceIDs)
+            fixture.adapter.writeScalarQuantityOnFace(fixture.dataID, faceID,
+                                                      1.);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void writeQuantityOnFaces(benchmark::State &state)
+{
+    AdapterFixture fixture(int(state.range(0)));
+    const std::vector<double> values(fixture.faceIDs.size(), 1.);
+    for (auto _ : state) {
+        fixture.adapter.writeQuantityOnFaces(fixture.dataID, fixture.faceIDs,
+                                             values);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void writeQuantityOnFacesInMeshOrder(benchmark::State &state)
+{
+    AdapterFixture fixture(int(state.range(0)));
+    const std::vector<double> values(fixture.faceIDs.size(), 1.);
+    for (auto _ : state) {
+        fixture.adapter.writeQuantityOnFaces(fixture.dataID, values);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void writeQuantityVector(benchmark::State &state)
+{
+    AdapterFixture fixture(int(state.range(0)));
+    const std::vector<double> values(fixture.faceIDs.size(), 1.);
+    for (auto _ : state) {
+        fixture.adapter.writeQuantityVector(fixture.dataID, values);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            sizeof(double));
+}
+
+void writeQuantityToOtherSolver(benchmark::State &state)
+{
+    AdapterFixture fixture(int(state.range(0)));
+    for (auto _ : state) {
+        fixture.adapter.writeScalarQuantityToOtherSolver(fixture.dataID);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void getIdFromName(benchmark::State &state)
+{
+    // The lookup does not depend on the interface size
+    AdapterFixture fixture(100);
+    // Typical number of fields exchanged in species-transport setups
+    for (int i = 0; i < 9; ++i)
+        fixture.adapter.announceScalarQuantity("Concentration" +
+                                               std::to_string(i));
+    const std::string name = "Concentration8";
+    for (auto _ : state)
+        benchmark::DoNotOptimize(fixture.adapter.getIdFromName(name));
+}
+
+//! Interface sizes from 10^2 to 10^6 faces.
+void interfaceSizes(benchmark::internal::Benchmark *benchmark)
+{
+    benchmark->RangeMultiplier(10)->Range(100, 1000000);
+}
+}  // namespace
+
+BENCHMARK_CAPTURE(indexMapperCreateMapping, dense, IndexMappingType::Dense)
+    ->Apply(interfaceSizes);
+BENCHMARK_CAPTURE(indexMapperCreateMapping, sparse, IndexMappingType::Sparse)
+    ->Apply(interfaceSizes);
+BENCHMARK_CAPTURE(indexMapperLookup, dense, IndexMappingType::Dense)
+    ->Apply(interfaceSizes);
+BENCHMARK_CAPTURE(indexMapperLookup, sparse, IndexMappingType::Sparse)
+    ->Apply(interfaceSizes);
+BENCHMARK(writeScalarQuantityOnFace)->Apply(interfaceSizes);
+BENCHMARK(writeQuantityOnFaces)->Apply(interfaceSizes);
+BENCHMARK(writeQuantityOnFacesInMeshOrder)->Apply(interfaceSizes);
+BENCHMARK(writeQuantityVector)->Apply(interfaceSizes);
+BENCHMARK(writeQuantityToOtherSolver)->Apply(interfaceSizes);
+BENCHMARK(getIdFromName);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,185 @@
+/*!
+ * @brief Stand-in for preCICE's SolverInterface used by the benchmarks.
+ *
+ * The benchmarks measure the overhead of the adapter itself and must run
+ * without a coupling partner. This file implements the parts of
+ * precice::SolverInterface used by the adapter and is linked instead of
+ * the preCICE library. Block reads and writes copy from and to local
+ * buffers, all other calls return immediately.
+ */
+#include <precice/SolverInterface.hpp>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace precice
+{
+namespace impl
+{
+class SolverInterfaceImpl
+{
+public:
+    //! Number of spatial dimensions reported to the adapter.
+    static constexpr int dimensions = 3;
+    //! Identifiers of the meshes by name.
+    std::map<std::string, int> meshIDs;
+    //! Number of vertices per mesh.
+    std::vector<int> meshSizes;
+    //! Identifiers of the data by name and mesh.
+    std::map<std::pair<std::string, int>, int> dataIDs;
+    //! Values of the data, dimensions values per vertex.
+    std::vector<std::vector<double> > data;
+};
+}  // namespace impl
+
+SolverInterface::SolverInterface(const std::string &,
+                                 const std::string &,
+                                 int,
+                                 int)
+    : _impl(new impl::SolverInterfaceImpl())
+{
+}
+
+SolverInterface::SolverInterface(const std::string &,
+                                 const std::string &,
+                                 int,
+                                 int,
+                                 void *)
+    : _impl(new impl::SolverInterfaceImpl())
+{
+}
+
+SolverInterface::~SolverInterface() = default;
+
+double SolverInterface::initialize()
+{
+    return 1.;
+}
+
+void SolverInterface::initializeData() {}
+
+double SolverInterface::advance(double)
+{
+    return 1.;
+}
+
+void SolverInterface::finalize() {}
+
+int SolverInterface::getDimensions() const
+{
+    return impl::SolverInterfaceImpl::dimensions;
+}
+
+bool SolverInterface::isCouplingOngoing() const
+{
+    return false;
+}
+
+bool SolverInterface::isTimeWindowComplete() const
+{
+    return true;
+}
+
+bool SolverInterface::isActionRequired(const std::string &) const
+{
+    return false;
+}
+
+void SolverInterface::markActionFulfilled(const std::string &) {}
+
+int SolverInterface::getMeshID(const std::string &meshName) const
+{
+    const auto inserted =
+        _impl->meshIDs.emplace(meshName, int(_impl->meshSizes.size()));
+    if (inserted.second)
+        _impl->meshSizes.push_back(0);
+    return inserted.first->second;
+}
+
+int SolverInterface::getDataID(const std::string &dataName, int meshID) const
+{
+    const auto inserted = _impl->dataIDs.emplace(
+        std::make_pair(dataName, meshID), int(_impl->data.size()));
+    if (inserted.second)
+        _impl->data.emplace_back(std::size_t(_impl->meshSizes[meshID]) *
+                                 impl::SolverInterfaceImpl::dimensions);
+    return inserted.first->second;
+}
+
+void SolverInterface::setMeshVertices(int meshID,
+                                      int size,
+                                      const double *,
+                                      int *ids)
+{
+    for (int i = 0; i < size; ++i)
+        ids[i] = _impl->meshSizes[meshID]++;
+}
+
+void SolverInterface::writeBlockVectorData(int dataID,
+                                           int size,
+                                           const int *valueIndices,
+                                           const double *values)
+{
+    constexpr int dim = impl::SolverInterfaceImpl::dimensions;
+    auto &data = _impl->data[dataID];
+    for (int i = 0; i < size; ++i)
+        for (int d = 0; d < dim; ++d)
+            data[valueIndices[i] * dim + d] = values[i * dim + d];
+}
+
+void SolverInterface::writeBlockScalarData(int dataID,
+                                           int size,
+                                           const int *valueIndices,
+                                           const double *values)
+{
+    auto &data = _impl->data[dataID];
+    for (int i = 0; i < size; ++i)
+        data[valueIndices[i]] = values[i];
+}
+
+void SolverInterface::readBlockVectorData(int dataID,
+                                          int size,
+                                          const int *valueIndices,
+                                          double *values) const
+{
+    constexpr int dim = impl::SolverInterfaceImpl::dimensions;
+    const auto &data = _impl->data[dataID];
+    for (int i = 0; i < size; ++i)
+        for (int d = 0; d < dim; ++d)
+            values[i * dim + d] = data[valueIndices[i] * dim + d];
+}
+
+void SolverInterface::readBlockScalarData(int dataID,
+                                          int size,
+                                          const int *valueIndices,
+                                          double *values) const
+{
+    const auto &data = _impl->data[dataID];
+    for (int i = 0; i < size; ++i)
+        values[i] = data[valueIndices[i]];
+}
+
+namespace constants
+{
+const std::string &actionWriteInitialData()
+{
+    static const std::string name("write-initial-data");
+    return name;
+}
+
+const std::string &actionWriteIterationCheckpoint()
+{
+    static const std::string name("write-iteration-checkpoint");
+    return name;
+}
+
+const std::string &actionReadIterationCheckpoint()
+{
+    static const std::string name("read-iteration-checkpoint");
+    return name;
+}
+}  // namespace constants
+
+}  // namespace precice
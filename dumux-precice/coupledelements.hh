@@ -0,0 +1,152 @@
+#ifndef DUMUXPRECICE_COUPLEDELEMENTS_HH
+#define DUMUXPRECICE_COUPLEDELEMENTS_HH
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <dune/grid/common/partitionset.hh>
+
+#include "couplingadapter.hh"
+#include "interfacevertices.hh"
+
+namespace Dumux::Precice
+{
+/*!
+ * @brief List of the elements touching the coupling interface.
+ *
+ * The list is created once after the index mapping of the coupling adapter
+ * has been created. It stores the seeds of all elements that have at least
+ * one coupled sub control volume face together with the indices of these
+ * faces. Loops that extract data on the coupling interface can then iterate
+ * over the coupled elements only instead of over the whole grid. Only
+ * interior elements are considered, see InterfaceVertices.
+ *
+ * @tparam GridGeometry Type of the DuMuX grid geometry.
+ */
+template<class GridGeometry>
+class CoupledElements
+{
+    using GridView = typename GridGeometry::GridView;
+    using Element = typename GridView::template Codim<0>::Entity;
+    using ElementSeed = typename Element::EntitySeed;
+
+public:
+    /*!
+     * @brief Element with at least one face on the coupling interface.
+     *
+     */
+    struct CoupledElement {
+        //! Seed of the element.
+        ElementSeed seed;
+        //! Indices of the element's sub control volume faces on the coupling interface.
+        std::vector<std::size_t> scvfIndices;
+    };
+
+    /*!
+     * @brief Collects the elements touching the coupling interface.
+     *
+     * @param[in] gridGeometry Grid geometry of the coupled domain.
+     * @param[in] couplingInterface Coupling adapter with a valid index mapping.
+     */
+    void update(const GridGeometry &gridGeometry,
+                const CouplingAdapter &couplingInterface)
+    {
+        coupledElements_.clear();
+        faceIDs_.clear();
+
+        auto fvGeometry = localView(gridGeometry);
+        for (const auto &element :
+             elements(gridGeometry.gridView(), Dune::Partitions::interior)) {
+            fvGeometry.bindElement(element);
+
+            CoupledElement coupledElement{element.seed(), {}};
+            for (const auto &scvf : scvfs(fvGeometry)) {
+                if (couplingInterface.isCoupledEntity(scvf.index())) {
+                    coupledElement.scvfIndices.push_back(scvf.index());
+                    faceIDs_.push_back(scvf.index());
+                }
+            }
+
+            if (!coupledElement.scvfIndices.empty())
+                coupledElements_.push_back(std::move(coupledElement));
+        }
+    }
+
+    /*!
+     * @brief Takes the elements touching the coupling interface from the
+     *        collected interface vertices.
+     *
+     * Unlike the overload taking the coupling adapter, no loop over all
+     * elements is needed. The coupled faces are the faces of the interface
+     * vertices, which is the same as long as the domain has a single
+     * coupling mesh. The faces of the list are in the order of the faces
+     * passed to createIndexMapping by InterfaceVertices::setMesh, so values
+     * collected by a loop over the list can be passed to the overloads of
+     * CouplingAdapter::writeQuantityOnFaces without face identifiers.
+     *
+     * @param[in] gridGeometry Grid geometry of the coupled domain.
+     * @param[in] interfaceVertices Vertices of the coupling mesh.
+     */
+    void update(const GridGeometry &gridGeometry,
+                const InterfaceVertices<GridGeometry> &interfaceVertices)
+    {
+        const auto &elementIndices = interfaceVertices.elementIndices();
+        const auto &offsets = interfaceVertices.elementFaceOffsets();
+        const auto &faceIDs = interfaceVertices.faceIDs();
+
+        coupledElements_.clear();
+        coupledElements_.reserve(elementIndices.size());
+        faceIDs_.assign(faceIDs.begin(), faceIDs.end());
+        for (std::size_t i = 0; i < elementIndices.size(); ++i) {
+            const auto element = gridGeometry.element(elementIndices[i]);
+            coupledElements_.push_back(
+                {element.seed(),
+                 {faceIDs.begin() + offsets[i],
+                  faceIDs.begin() + offsets[i + 1]}});
+        }
+    }
+
+    /*!
+     * @brief Gets the element belonging to an entry of the list.
+     *
+     * @param[in] gridGeometry Grid geometry of the coupled domain.
+     * @param[in] coupledElement Entry of the list.
+     * @return Element The grid element.
+     */
+    static Element element(const GridGeometry &gridGeometry,
+                           const CoupledElement &coupledElement)
+    {
+        return gridGeometry.gridView().grid().entity(coupledElement.seed);
+    }
+
+    /*!
+     * @brief Gets the identifiers of all coupled faces.
+     *
+     * The faces are ordered like they are visited when iterating over the
+     * coupled elements and their sub control volume face indices.
+     *
+     * @return const std::vector<int>& Face identifiers according to DuMuX' numbering.
+     */
+    const std::vector<int> &faceIDs() const { return faceIDs_; }
+
+    /*!
+     * @brief Gets the number of elements touching the coupling interface.
+     *
+     * @return std::size_t Number of coupled elements.
+     */
+    std::size_t size() const { return coupledElements_.size(); }
+
+    auto begin() const { return coupledElements_.begin(); }
+    auto end() const { return coupledElements_.end(); }
+
+private:
+    //! Elements touching the coupling interface.
+    std::vector<CoupledElement> coupledElements_;
+    //! Identifiers of all coupled faces in iteration order.
+    std::vector<int> faceIDs_;
+};
+
+}  // namespace Dumux::Precice
+
+#endif  // DUMUXPRECICE_COUPLEDELEMENTS_HH
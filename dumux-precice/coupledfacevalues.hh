@@ -0,0 +1,109 @@
+#ifndef DUMUXPRECICE_COUPLEDFACEVALUES_HH
+#define DUMUXPRECICE_COUPLEDFACEVALUES_HH
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "couplingadapter.hh"
+
+namespace Dumux::Precice
+{
+/*!
+ * @brief Copies of scalar coupling quantities for the boundary conditions
+ *        of a problem.
+ *
+ * Boundary conditions are evaluated for every boundary face in every
+ * residual evaluation, i.e. many times per Newton step with numeric
+ * differentiation. Asking the coupling adapter each time requires a lookup
+ * of the face in the index mapping. This class stores the values of every
+ * cached quantity in an array indexed by the sub control volume face
+ * index, so that isCoupled and value are plain array accesses. A problem
+ * holds an instance, marks the coupled faces once via setCoupledFaces and
+ * calls update for its quantities after every read from preCICE.
+ *
+ */
+class CoupledFaceValues
+{
+public:
+    /*!
+     * @brief Marks the faces of the coupling interface.
+     *
+     * Must be called after the index mappings have been created.
+     *
+     * @param[in] couplingInterface The coupling adapter.
+     * @param[in] numFaces Number of sub control volume faces of the grid.
+     */
+    void setCoupledFaces(const CouplingAdapter &couplingInterface,
+                         const std::size_t numFaces)
+    {
+        isCoupled_.assign(numFaces, 0);
+        faceIDs_.clear();
+        for (std::size_t faceID = 0; faceID < numFaces; ++faceID)
+            if (couplingInterface.isCoupledEntity(int(faceID))) {
+                isCoupled_[faceID] = 1;
+                faceIDs_.push_back(int(faceID));
+            }
+        values_.clear();
+    }
+
+    /*!
+     * @brief Copies the current values of a scalar quantity from the adapter.
+     *
+     * @param[in] couplingInterface The coupling adapter.
+     * @param[in] dataID Identifier of the quantity.
+     */
+    void update(const CouplingAdapter &couplingInterface, const size_t dataID)
+    {
+        if (values_.size() <= dataID)
+            values_.resize(dataID + 1);
+        auto &values = values_[dataID];
+        values.resize(isCoupled_.size(), 0.);
+
+        couplingInterface.readQuantityOnFaces(dataID, faceIDs_, buffer_);
+        assert(buffer_.size() == faceIDs_.size());
+        for (std::size_t i = 0; i < faceIDs_.size(); ++i)
+            values[faceIDs_[i]] = buffer_[i];
+    }
+
+    /*!
+     * @brief Checks whether a face is part of the coupling interface.
+     *
+     * @param[in] faceID Index of the sub control volume face.
+     * @return true The face is coupled.
+     * @return false The face is not coupled or setCoupledFaces has not been
+     *         called yet.
+     */
+    bool isCoupled(const std::size_t faceID) const
+    {
+        return faceID < isCoupled_.size() && isCoupled_[faceID];
+    }
+
+    /*!
+     * @brief Gets the value of a quantity on a coupled face.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     * @param[in] faceID Index of the sub control volume face.
+     * @return double Value as of the last update of the quantity.
+     */
+    double value(const size_t dataID, const std::size_t faceID) const
+    {
+        assert(dataID < values_.size() && !values_[dataID].empty());
+        assert(isCoupled(faceID));
+        return values_[dataID][faceID];
+    }
+
+private:
+    //! Flag for every face whether it is coupled.
+    std::vector<char> isCoupled_;
+    //! Identifiers of the coupled faces.
+    std::vector<int> faceIDs_;
+    //! Values of every cached quantity, indexed by the face index.
+    std::vector<std::vector<double> > values_;
+    //! Values of a quantity on the coupled faces in the order of faceIDs_.
+    std::vector<double> buffer_;
+};
+
+}  // namespace Dumux::Precice
+
+#endif  // DUMUXPRECICE_COUPLEDFACEVALUES_HH
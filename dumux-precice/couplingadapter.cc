@@ -1,24 +1,272 @@
 #include "couplingadapter.hh"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
 #include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
 #include <limits>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 
 using namespace Dumux::Precice;
 
+namespace
+{
+/*!
+ * @brief Spreads the lowest bits of a value such that `stride - 1` zero bits
+ *        are put between two consecutive bits.
+ *
+ * @param[in] value Value to spread.
+ * @param[in] bits Number of bits of value to use.
+ * @param[in] stride Distance of two consecutive bits in the result.
+ * @return std::uint64_t The spread bits.
+ */
+std::uint64_t spreadBits(const std::uint64_t value,
+                         const int bits,
+                         const int stride)
+{
+    std::uint64_t result = 0;
+    for (int b = 0; b < bits; ++b)
+        result |= ((value >> b) & std::uint64_t(1)) << (b * stride);
+    return result;
+}
+
+/*!
+ * @brief Sorts points along the Morton (Z-order) space-filling curve.
+ *
+ * @param[in] coordinates Coordinates of the points, stored consecutively.
+ * @param[in] dim Number of spatial dimensions.
+ * @return std::vector<size_t> Indices of the points in curve order.
+ */
+std::vector<size_t> mortonOrder(const std::vector<double> &coordinates,
+                                const int dim)
+{
+    const size_t numPoints = coordinates.size() / dim;
+    std::array<double, 3> lower, upper;
+    lower.fill(std::numeric_limits<double>::max());
+    upper.fill(std::numeric_limits<double>::lowest());
+    for (size_t i = 0; i < numPoints; ++i)
+        for (int d = 0; d < dim; ++d) {
+            lower[d] = std::min(lower[d], coordinates[i * dim + d]);
+            upper[d] = std::max(upper[d], coordinates[i * dim + d]);
+        }
+
+    const int bits = 64 / dim;
+    const double cells = double((std::uint64_t(1) << bits) - 1);
+    std::vector<std::uint64_t> codes(numPoints, 0);
+    for (size_t i = 0; i < numPoints; ++i)
+        for (int d = 0; d < dim; ++d) {
+            const double extent = upper[d] - lower[d];
+            const double x =
+                extent > 0. ? (coordinates[i * dim + d] - lower[d]) / extent
+                            : 0.;
+            codes[i] |= spreadBits(std::uint64_t(x * cells), bits, dim) << d;
+        }
+
+    std::vector<size_t> order(numPoints);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&codes](const size_t a, const size_t b) {
+                         return codes[a] < codes[b];
+                     });
+    return order;
+}
+
+/*!
+ * @brief Hash of the grid cell a point falls into.
+ *
+ */
+struct CellHash {
+    size_t operator()(const std::array<long long, 3> &cell) const
+    {
+        size_t h = 0;
+        for (const auto c : cell)
+            h = h * 1000003 ^ std::hash<long long>()(c);
+        return h;
+    }
+};
+
+/*!
+ * @brief Identifies snapshot files and their layout.
+ *
+ */
+constexpr std::array<char, 8> snapshotMagic = {'D', 'P', 'S', 'N',
+                                               'A', 'P', '0', '1'};
+
+/*!
+ * @brief Data of a snapshot, copied from the adapter and the solver.
+ *
+ */
+struct Snapshot {
+    std::uint64_t timeWindowIndex = 0;
+    double time = 0.;
+    std::vector<std::string> meshNames;
+    std::vector<std::vector<int> > meshBufferIndices;
+    std::vector<std::string> dataNames;
+    std::vector<std::uint64_t> dataMeshes;
+    std::vector<std::vector<double> > dataVectors;
+    std::vector<double> solverState;
+};
+
+template<class T>
+void writeValue(std::ostream &os, const T &value)
+{
+    os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template<class T>
+bool readValue(std::istream &is, T &value)
+{
+    return bool(is.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+template<class T>
+void writeVector(std::ostream &os, const std::vector<T> &values)
+{
+    writeValue(os, std::uint64_t(values.size()));
+    os.write(reinterpret_cast<const char *>(values.data()),
+             values.size() * sizeof(T));
+}
+
+template<class T>
+bool readVector(std::istream &is, std::vector<T> &values)
+{
+    std::uint64_t size;
+    if (!readValue(is, size))
+        return false;
+    values.resize(size);
+    return bool(is.read(reinterpret_cast<char *>(values.data()),
+                        values.size() * sizeof(T)));
+}
+
+void writeString(std::ostream &os, const std::string &value)
+{
+    writeVector(os, std::vector<char>(value.begin(), value.end()));
+}
+
+bool readString(std::istream &is, std::string &value)
+{
+    std::vector<char> chars;
+    if (!readVector(is, chars))
+        return false;
+    value.assign(chars.begin(), chars.end());
+    return true;
+}
+
+/*!
+ * @brief Writes a snapshot to a temporary file and renames it afterwards,
+ *        so an interrupted write never destroys the previous snapshot.
+ *
+ * @param[in] snapshot The snapshot.
+ * @param[in] fileName File to write the snapshot to.
+ */
+void writeSnapshotFile(const Snapshot &snapshot, const std::string &fileName)
+{
+    const std::string tmpFileName = fileName + ".tmp";
+    {
+        std::ofstream ofs(tmpFileName, std::ios::binary | std::ios::trunc);
+        ofs.write(snapshotMagic.data(), snapshotMagic.size());
+        writeValue(ofs, snapshot.timeWindowIndex);
+        writeValue(ofs, snapshot.time);
+        writeValue(ofs, std::uint64_t(snapshot.meshNames.size()));
+        for (size_t i = 0; i < snapshot.meshNames.size(); ++i) {
+            writeString(ofs, snapshot.meshNames[i]);
+            writeVector(ofs, snapshot.meshBufferIndices[i]);
+        }
+        writeValue(ofs, std::uint64_t(snapshot.dataNames.size()));
+        for (size_t i = 0; i < snapshot.dataNames.size(); ++i) {
+            writeString(ofs, snapshot.dataNames[i]);
+            writeValue(ofs, snapshot.dataMeshes[i]);
+            writeVector(ofs, snapshot.dataVectors[i]);
+        }
+        writeVector(ofs, snapshot.solverState);
+        if (!ofs)
+            throw std::runtime_error("Writing the snapshot " + tmpFileName +
+                                     " failed!");
+    }
+    if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+        throw std::runtime_error("Renaming the snapshot " + tmpFileName +
+                                 " failed!");
+}
+
+/*!
+ * @brief Reads a snapshot.
+ *
+ * @param[out] snapshot The snapshot.
+ * @param[in] is Stream to read the snapshot from.
+ * @return true The snapshot was read completely.
+ * @return false The stream does not contain a valid snapshot.
+ */
+bool readSnapshotFile(Snapshot &snapshot, std::istream &is)
+{
+    std::array<char, 8> magic;
+    std::uint64_t numMeshes, numData;
+    if (!is.read(magic.data(), magic.size()) || magic != snapshotMagic ||
+        !readValue(is, snapshot.timeWindowIndex) ||
+        !readValue(is, snapshot.time) || !readValue(is, numMeshes))
+        return false;
+    snapshot.meshNames.resize(numMeshes);
+    snapshot.meshBufferIndices.resize(numMeshes);
+    for (size_t i = 0; i < numMeshes; ++i)
+        if (!readString(is, snapshot.meshNames[i]) ||
+            !readVector(is, snapshot.meshBufferIndices[i]))
+            return false;
+    if (!readValue(is, numData))
+        return false;
+    snapshot.dataNames.resize(numData);
+    snapshot.dataMeshes.resize(numData);
+    snapshot.dataVectors.resize(numData);
+    for (size_t i = 0; i < numData; ++i)
+        if (!readString(is, snapshot.dataNames[i]) ||
+            !readValue(is, snapshot.dataMeshes[i]) ||
+            !readVector(is, snapshot.dataVectors[i]))
+            return false;
+    return readVector(is, snapshot.solverState);
+}
+
+/*!
+ * @brief Gets the name of the snapshot file of a time window.
+ *
+ * @param[in] fileName File name passed to enableSnapshots.
+ * @param[in] timeWindow Number of completed time windows.
+ * @return std::string Name of the snapshot file.
+ */
+std::string snapshotFile(const std::string &fileName, const size_t timeWindow)
+{
+    return fileName + "." + std::to_string(timeWindow);
+}
+}  // namespace
+
 CouplingAdapter::CouplingAdapter()
     : wasCreated_(false),
       precice_(nullptr),
       meshWasCreated_(false),
       preciceWasInitialized_(false),
-      hasIndexMapper_(false),
-      meshID_(0),
-      timeStepSize_(0.)
+      timeStepSize_(0.),
+      asynchronousAdvance_(false),
+      timeWindowIndex_(0),
+      time_(0.),
+      windowTime_(0.),
+      pendingTimeStepLength_(0.),
+      writeStatisticsSummary_(false),
+      snapshotInterval_(0)
 {
+    meshes_.reserve(reserveSize_);
     preciceDataID_.reserve(reserveSize_);
     dataNames_.reserve(reserveSize_);
     dataVectors_.reserve(reserveSize_);
+    externalBuffers_.reserve(reserveSize_);
+    quantityTypes_.reserve(reserveSize_);
+    quantityMeshes_.reserve(reserveSize_);
 }
 
 CouplingAdapter &CouplingAdapter::getInstance()
@@ -38,58 +286,193 @@ void CouplingAdapter::announceSolver(const std::string &name,
     wasCreated_ = true;
 }
 
+void CouplingAdapter::announceSolver(const std::string &name,
+                                     const std::string configurationFileName,
+                                     const int rank,
+                                     const int size,
+                                     void *communicator)
+{
+    assert(precice_ == nullptr);
+    precice_ = std::make_unique<precice::SolverInterface>(
+        name, configurationFileName, rank, size, communicator);
+    wasCreated_ = true;
+}
+
 size_t CouplingAdapter::announceQuantity(const std::string &name,
                                          const QuantityType quantity_type)
+{
+    return announceQuantity(0, name, quantity_type);
+}
+
+size_t CouplingAdapter::announceQuantity(const size_t meshIndex,
+                                         const std::string &name,
+                                         const QuantityType quantity_type)
 {
     assert(meshWasCreated_);
-    auto it = std::find(dataNames_.begin(), dataNames_.end(), name);
-    if (it != dataNames_.end()) {
-        throw(std::runtime_error(" Error! Duplicate quantity announced! "));
+    assert(meshIndex < meshes_.size());
+    auto &idsWithName = quantityIDs_[name];
+    for (const auto id : idsWithName) {
+        if (quantityMeshes_[id] == meshIndex) {
+            throw(
+                std::runtime_error(" Error! Duplicate quantity announced! "));
+        }
     }
+    const CouplingMesh &mesh = meshes_[meshIndex];
+    // Keep the quantities of the name sorted by mesh index
+    const auto position = std::upper_bound(
+        idsWithName.begin(), idsWithName.end(), meshIndex,
+        [this](const size_t index, const size_t id) {
+            return index < quantityMeshes_[id];
+        });
+    idsWithName.insert(position, dataNames_.size());
     dataNames_.push_back(name);
-    preciceDataID_.push_back(precice_->getDataID(name, meshID_));
+    preciceDataID_.push_back(precice_->getDataID(name, mesh.preciceID));
     const int quantity_dimension =
         (quantity_type == QuantityType::Scalar) ? 1 : getDimensions();
     dataVectors_.push_back(
-        std::vector<double>(vertexIDs_.size() * quantity_dimension));
+        std::vector<double>(mesh.vertexIDs.size() * quantity_dimension));
+    externalBuffers_.push_back(nullptr);
+    quantityTypes_.push_back(quantity_type);
+    quantityMeshes_.push_back(meshIndex);
+    previousDataVectors_.emplace_back();
+    tracksChange_.push_back(false);
+    hasPreviousRead_.push_back(false);
+    changeNorms_.push_back(std::numeric_limits<double>::infinity());
+    dataNorms_.push_back(0.);
+    windowStartDataVectors_.emplace_back();
+    interpolatesInTime_.push_back(false);
+    lastReadTimeWindows_.push_back(noTimeWindow_);
 
     return getNumberOfQuantities() - 1;
 }
 
-size_t CouplingAdapter::announceScalarQuantity(const std::string &name)
+ScalarQuantityHandle CouplingAdapter::announceScalarQuantity(
+    const std::string &name)
 {
-    return announceQuantity(name, QuantityType::Scalar);
+    return ScalarQuantityHandle(announceQuantity(name, QuantityType::Scalar));
 }
 
-size_t CouplingAdapter::announceVectorQuantity(const std::string &name)
+ScalarQuantityHandle CouplingAdapter::announceScalarQuantity(
+    const size_t meshIndex,
+    const std::string &name)
 {
-    return announceQuantity(name, QuantityType::Vector);
+    return ScalarQuantityHandle(
+        announceQuantity(meshIndex, name, QuantityType::Scalar));
 }
 
-int CouplingAdapter::getDimensions() const
+VectorQuantityHandle CouplingAdapter::announceVectorQuantity(
+    const std::string &name)
 {
-    assert(wasCreated_);
-    return precice_->getDimensions();
+    return VectorQuantityHandle(announceQuantity(name, QuantityType::Vector));
 }
-/*
-void CouplingAdapter::setMeshName(const std::string& meshName)
+
+VectorQuantityHandle CouplingAdapter::announceVectorQuantity(
+    const size_t meshIndex,
+    const std::string &name)
 {
-  assert( wasCreated_ );
-  meshID_ = precice_->getMeshID(meshName);
+    return VectorQuantityHandle(
+        announceQuantity(meshIndex, name, QuantityType::Vector));
 }
-*/
 
-void CouplingAdapter::setMesh(const std::string &meshName,
-                              const size_t numPoints,
-                              std::vector<double> &coordinates)
+int CouplingAdapter::getDimensions() const
 {
     assert(wasCreated_);
+    return precice_->getDimensions();
+}
+size_t CouplingAdapter::setMesh(const std::string &meshName,
+                                const size_t numPoints,
+                                std::vector<double> &coordinates)
+{
+    assert(wasCreated_);
+    assert(!preciceWasInitialized_);
     assert(numPoints == coordinates.size() / getDimensions());
-    meshID_ = precice_->getMeshID(meshName);
-    vertexIDs_.resize(numPoints);
-    precice_->setMeshVertices(meshID_, numPoints, coordinates.data(),
-                              vertexIDs_.data());
+    for (const auto &mesh : meshes_) {
+        if (mesh.name == meshName) {
+            throw(std::runtime_error(" Error! Duplicate mesh announced! "));
+        }
+    }
+    CouplingMesh mesh;
+    mesh.name = meshName;
+    mesh.preciceID = precice_->getMeshID(meshName);
+    mesh.numberOfInputPoints = numPoints;
+    mesh.vertexIDs.resize(numPoints);
+    precice_->setMeshVertices(mesh.preciceID, numPoints, coordinates.data(),
+                              mesh.vertexIDs.data());
+    meshes_.push_back(std::move(mesh));
     meshWasCreated_ = true;
+    return meshes_.size() - 1;
+}
+
+size_t CouplingAdapter::setMesh(const std::string &meshName,
+                                const size_t numPoints,
+                                std::vector<double> &coordinates,
+                                const VertexOrdering ordering,
+                                const bool deduplicate,
+                                const double tolerance)
+{
+    const int dim = getDimensions();
+    assert(numPoints == coordinates.size() / dim);
+    if (ordering == VertexOrdering::Input && !deduplicate)
+        return setMesh(meshName, numPoints, coordinates);
+
+    std::vector<size_t> order;
+    if (ordering == VertexOrdering::Morton)
+        order = mortonOrder(coordinates, dim);
+    else {
+        order.resize(numPoints);
+        std::iota(order.begin(), order.end(), 0);
+    }
+
+    // Points closer than the tolerance in every coordinate are considered
+    // coincident. The vertices are hashed into a grid with the tolerance as
+    // cell size, so coincident points lie in the same or in neighbouring
+    // cells, and every cell holds at most one vertex.
+    std::unordered_map<std::array<long long, 3>, size_t, CellHash> cells;
+    std::vector<size_t> inputToVertex(numPoints);
+    std::vector<double> vertexCoordinates;
+    vertexCoordinates.reserve(coordinates.size());
+    int numNeighbours = 1;
+    for (int d = 0; d < dim; ++d)
+        numNeighbours *= 3;
+    for (const auto i : order) {
+        const size_t vertex = vertexCoordinates.size() / dim;
+        if (deduplicate) {
+            const double *point = coordinates.data() + i * dim;
+            std::array<long long, 3> cell{0, 0, 0};
+            for (int d = 0; d < dim; ++d)
+                cell[d] = std::llround(point[d] / tolerance);
+
+            bool isCoincident = false;
+            for (int n = 0; n < numNeighbours && !isCoincident; ++n) {
+                auto neighbour = cell;
+                for (int d = 0, code = n; d < dim; ++d, code /= 3)
+                    neighbour[d] += code % 3 - 1;
+                const auto it = cells.find(neighbour);
+                if (it == cells.end())
+                    continue;
+                const double *other =
+                    vertexCoordinates.data() + it->second * dim;
+                isCoincident = true;
+                for (int d = 0; d < dim; ++d)
+                    isCoincident = isCoincident &&
+                                   std::abs(point[d] - other[d]) <= tolerance;
+                if (isCoincident)
+                    inputToVertex[i] = it->second;
+            }
+            if (isCoincident)
+                continue;
+            cells.emplace(cell, vertex);
+        }
+        inputToVertex[i] = vertex;
+        for (int d = 0; d < dim; ++d)
+            vertexCoordinates.push_back(coordinates[i * dim + d]);
+    }
+
+    const size_t meshIndex = setMesh(
+        meshName, vertexCoordinates.size() / dim, vertexCoordinates);
+    meshes_[meshIndex].numberOfInputPoints = numPoints;
+    meshes_[meshIndex].inputToVertex = std::move(inputToVertex);
+    return meshIndex;
 }
 
 double CouplingAdapter::initialize()
@@ -98,18 +481,46 @@ double CouplingAdapter::initialize()
     assert(meshWasCreated_);
     assert(!preciceWasInitialized_);
 
-    timeStepSize_ = precice_->initialize();
+    {
+        CouplingStatistics::ScopedTimer timer(statistics_,
+                                              CouplingPhase::Initialize);
+        timeStepSize_ = precice_->initialize();
+    }
     assert(timeStepSize_ > 0);
 
     preciceWasInitialized_ = true;
     return timeStepSize_;
 }
 
-void CouplingAdapter::createIndexMapping(const std::vector<int> &dumuxFaceIDs)
+void CouplingAdapter::createIndexMapping(const std::vector<int> &dumuxFaceIDs,
+                                         const IndexMappingType mappingType)
+{
+    createIndexMapping(0, dumuxFaceIDs, mappingType);
+}
+
+void CouplingAdapter::createIndexMapping(const size_t meshIndex,
+                                         const std::vector<int> &dumuxFaceIDs,
+                                         const IndexMappingType mappingType)
 {
     assert(meshWasCreated_);
-    indexMapper_.createMapping(dumuxFaceIDs, vertexIDs_);
-    hasIndexMapper_ = true;
+    assert(meshIndex < meshes_.size());
+    CouplingMesh &mesh = meshes_[meshIndex];
+    if (mesh.setupDataWasReleased) {
+        throw(std::runtime_error(
+            " Error! Setup data of the mesh has been released! "));
+    }
+    assert(dumuxFaceIDs.size() == mesh.numberOfInputPoints);
+    if (mesh.inputToVertex.empty())
+        mesh.faceOrderToBufferIndex = mesh.vertexIDs;
+    else {
+        mesh.faceOrderToBufferIndex.resize(mesh.inputToVertex.size());
+        for (size_t i = 0; i < mesh.inputToVertex.size(); ++i)
+            mesh.faceOrderToBufferIndex[i] =
+                mesh.vertexIDs[mesh.inputToVertex[i]];
+    }
+    mesh.indexMapper.createMapping(dumuxFaceIDs, mesh.faceOrderToBufferIndex,
+                                   mappingType);
+    mesh.hasIndexMapper = true;
 }
 
 double CouplingAdapter::setMeshAndInitialize(const std::string &meshName,
@@ -123,125 +534,398 @@ double CouplingAdapter::setMeshAndInitialize(const std::string &meshName,
 void CouplingAdapter::initializeData()
 {
     assert(preciceWasInitialized_);
-    precice_->initializeData();
+    {
+        CouplingStatistics::ScopedTimer timer(statistics_,
+                                              CouplingPhase::InitializeData);
+        precice_->initializeData();
+    }
+    statistics_.startSolverPhase();
 }
 
 void CouplingAdapter::finalize()
 {
     assert(wasCreated_);
+    if (isAdvancePending())
+        finishAdvance();
+    if (pendingSnapshot_.valid())
+        pendingSnapshot_.get();
+    statistics_.finishSolverPhase();
     if (preciceWasInitialized_)
         precice_->finalize();
+    if (residualLog_.is_open())
+        residualLog_.close();
+
+    if (writeStatisticsSummary_) {
+        statistics_.printSummary(std::cout);
+        printMemoryUsage(std::cout);
+        if (!statisticsFileName_.empty()) {
+            std::ofstream ofs(statisticsFileName_,
+                              std::ofstream::out | std::ofstream::trunc);
+            statistics_.writeJson(ofs);
+        }
+    }
 }
 
 double CouplingAdapter::advance(const double computedTimeStepLength)
 {
     assert(wasCreated_);
+    assert(!isAdvancePending());
+    statistics_.finishSolverPhase();
+    const double maxTimeStepSize = advancePrecice_(computedTimeStepLength);
+    completeIteration_(computedTimeStepLength);
+    statistics_.startSolverPhase();
+    return maxTimeStepSize;
+}
+
+void CouplingAdapter::setAsynchronousAdvance(const bool enable)
+{
+    assert(!isAdvancePending());
+    asynchronousAdvance_ = enable;
+}
+
+void CouplingAdapter::startAdvance(const double computedTimeStepLength)
+{
+    assert(wasCreated_);
+    assert(!isAdvancePending());
+    statistics_.finishSolverPhase();
+    const auto policy =
+        asynchronousAdvance_ ? std::launch::async : std::launch::deferred;
+    pendingTimeStepLength_ = computedTimeStepLength;
+    pendingAdvance_ = std::async(policy, &CouplingAdapter::advancePrecice_,
+                                 this, computedTimeStepLength);
+}
+
+double CouplingAdapter::finishAdvance()
+{
+    assert(wasCreated_);
+    assert(isAdvancePending());
+    const double maxTimeStepSize = pendingAdvance_.get();
+    completeIteration_(pendingTimeStepLength_);
+    statistics_.startSolverPhase();
+    return maxTimeStepSize;
+}
+
+void CouplingAdapter::completeIteration_(const double computedTimeStepLength)
+{
+    const bool timeWindowComplete = precice_->isTimeWindowComplete();
+    const bool iterationComplete =
+        timeWindowComplete ||
+        precice_->isActionRequired(
+            precice::constants::actionReadIterationCheckpoint());
+    statistics_.completeIteration(timeWindowComplete);
+    // A substep of a subcycled time window does not end a coupling iteration
+    if (iterationComplete)
+        recordResidual_(timeWindowComplete);
+    windowTime_ += computedTimeStepLength;
+    if (timeWindowComplete) {
+        ++timeWindowIndex_;
+        time_ += windowTime_;
+        windowTime_ = 0.;
+    } else if (iterationComplete)
+        // the time window is repeated
+        windowTime_ = 0.;
+}
+
+double CouplingAdapter::advancePrecice_(const double computedTimeStepLength)
+{
+    CouplingStatistics::ScopedTimer timer(statistics_, CouplingPhase::Advance);
     return precice_->advance(computedTimeStepLength);
 }
 
+void CouplingAdapter::enableStatisticsSummary(const std::string &jsonFileName)
+{
+    writeStatisticsSummary_ = true;
+    statisticsFileName_ = jsonFileName;
+}
+
+size_t MemoryUsage::total() const
+{
+    size_t bytes = 0;
+    for (const auto &entry : quantities)
+        bytes += entry.bytes;
+    for (const auto &entry : structures)
+        bytes += entry.bytes;
+    return bytes;
+}
+
+MemoryUsage CouplingAdapter::getMemoryUsage() const
+{
+    const auto bytesOf = [](const auto &v) {
+        using Value = typename std::decay_t<decltype(v)>::value_type;
+        return v.capacity() * sizeof(Value);
+    };
+
+    MemoryUsage usage;
+    for (size_t i = 0; i < dataNames_.size(); ++i) {
+        usage.quantities.push_back(
+            {dataNames_[i] + " on " + meshes_[quantityMeshes_[i]].name,
+             bytesOf(dataVectors_[i]) + bytesOf(previousDataVectors_[i]) +
+                 bytesOf(windowStartDataVectors_[i])});
+    }
+    for (const auto &mesh : meshes_) {
+        usage.structures.push_back(
+            {mesh.name + " vertex identifiers", bytesOf(mesh.vertexIDs)});
+        usage.structures.push_back(
+            {mesh.name + " input order", bytesOf(mesh.inputToVertex)});
+        usage.structures.push_back(
+            {mesh.name + " face order", bytesOf(mesh.faceOrderToBufferIndex)});
+        usage.structures.push_back({mesh.name + " index mapping",
+                                    mesh.indexMapper.getMemoryUsage()});
+    }
+    return usage;
+}
+
+void CouplingAdapter::printMemoryUsage(std::ostream &os) const
+{
+    const auto usage = getMemoryUsage();
+    const auto printEntries =
+        [&os](const std::vector<MemoryUsage::Entry> &entries) {
+            for (const auto &entry : entries)
+                os << "    " << std::left << std::setw(40) << entry.name
+                   << std::right << std::setw(14) << entry.bytes
+                   << " bytes\n";
+        };
+
+    os << "Coupling adapter memory usage\n";
+    os << "  quantities\n";
+    printEntries(usage.quantities);
+    os << "  structures\n";
+    printEntries(usage.structures);
+    os << "  total: " << usage.total() << " bytes\n";
+}
+
+void CouplingAdapter::releaseSetupData()
+{
+    assert(wasCreated_);
+    assert(preciceWasInitialized_);
+    for (auto &mesh : meshes_) {
+        if (!mesh.hasIndexMapper)
+            continue;
+        std::vector<size_t>().swap(mesh.inputToVertex);
+        mesh.setupDataWasReleased = true;
+        mesh.vertexIDs.shrink_to_fit();
+        mesh.faceOrderToBufferIndex.shrink_to_fit();
+    }
+    for (auto &data : dataVectors_)
+        data.shrink_to_fit();
+}
+
 bool CouplingAdapter::isCouplingOngoing()
 {
     assert(wasCreated_);
+    assert(!isAdvancePending());
     return precice_->isCouplingOngoing();
 }
 
 size_t CouplingAdapter::getNumberOfVertices()
+{
+    return getNumberOfVertices(0);
+}
+
+size_t CouplingAdapter::getNumberOfVertices(const size_t meshIndex)
 {
     assert(wasCreated_);
-    return vertexIDs_.size();
+    assert(meshIndex < meshes_.size());
+    return meshes_[meshIndex].vertexIDs.size();
+}
+
+size_t CouplingAdapter::getNumberOfMeshes() const
+{
+    return meshes_.size();
+}
+
+size_t CouplingAdapter::getMeshIndex(const size_t dataID) const
+{
+    assert(dataID < quantityMeshes_.size());
+    return quantityMeshes_[dataID];
 }
 
 double CouplingAdapter::getScalarQuantityOnFace(const size_t dataID,
                                                 const int faceID) const
 {
     assert(wasCreated_);
-    assert(hasIndexMapper_);
-    if (!hasIndexMapper_) {
+    assert(dataID < dataVectors_.size());
+    const CouplingMesh &mesh = meshes_[quantityMeshes_[dataID]];
+    assert(mesh.hasIndexMapper);
+    if (!mesh.hasIndexMapper) {
         throw std::runtime_error(
             "Reading quantity using faceID, but index mapping was not "
             "created!");
     }
-    const auto idx = indexMapper_.getPreciceId(faceID);
-    assert(dataID < dataVectors_.size());
-    const std::vector<double> &quantityVector = dataVectors_[dataID];
-    assert(idx < quantityVector.size());
-    return quantityVector[idx];
-}
-
-// std::vector<double> getVectorQuantityOnFace(const size_t dataID, const int faceID) const
-// {
-//     assert(wasCreated_);
-//     assert(hasIndexMapper_);
-//     if (!hasIndexMapper_) {
-//         throw std::runtime_error(
-//             "Reading quantity using faceID, but index mapping was not "
-//             "created!");
-//     }
-//     const auto idx = indexMapper_.getPreciceId(faceID);
-//     assert(dataID < dataVectors_.size());
-//     const std::vector<double> &quantityVector = dataVectors_[dataID];
-//     assert(idx+getDimension()-1 < quantityVector.size());
-//     std::vector<double> vector_quantity( quantityVector.begin(), quantityVector.begin()+getDimension()-1 );
-//     return vector_quantity;
-// }
-// void getQuantityVector(const size_t dataID, std::vector<double>& quantity_vector) const
-// {
-//     assert(wasCreated_);
-//     assert(hasIndexMapper_);
-//     if (!hasIndexMapper_) {
-//         throw std::runtime_error(
-//             "Reading quantity using faceID, but index mapping was not "
-//             "created!");
-//     }
-//     const auto idx = indexMapper_.getPreciceId(faceID);
-//     const std::vector<double>& data_vector = dataVectors_[dataID];
-//     assert(dataID < data_vector.size());
-//     quantity_vector.resize( data_vector.size() );
-//     std::copy( data_vector.begin(), data_vector.end(), quantity_vector.begin() );
-// }
+    const auto idx = mesh.indexMapper.getPreciceId(faceID);
+    assert(size_t(idx) < getQuantitySize_(dataID));
+    return getQuantityData_(dataID)[idx];
+}
 
 void CouplingAdapter::writeScalarQuantityOnFace(const size_t dataID,
                                                 const int faceID,
                                                 const double value)
 {
     assert(wasCreated_);
-    assert(hasIndexMapper_);
-    if (!hasIndexMapper_) {
+    assert(dataID < dataVectors_.size());
+    const CouplingMesh &mesh = meshes_[quantityMeshes_[dataID]];
+    assert(mesh.hasIndexMapper);
+    if (!mesh.hasIndexMapper) {
         throw std::runtime_error(
             "Writing quantity using faceID, but index mapping was not "
             "created!");
     }
-    const auto idx = indexMapper_.getPreciceId(faceID);
+    const auto idx = mesh.indexMapper.getPreciceId(faceID);
+    assert(size_t(idx) < getQuantitySize_(dataID));
+    getQuantityData_(dataID)[idx] = value;
+}
+
+void CouplingAdapter::writeQuantityOnFaces(const size_t dataID,
+                                           const std::vector<int> &faceIDs,
+                                           const std::vector<double> &values)
+{
+    assert(wasCreated_);
+    assert(dataID < dataVectors_.size());
+    const size_t numComponents = getNumberOfComponents_(dataID);
+    assert(values.size() == faceIDs.size() * numComponents);
+
+    double *quantityVector = getQuantityData_(dataID);
+    for (size_t i = 0; i < faceIDs.size(); ++i) {
+        const size_t idx =
+            getBufferIndex_(dataID, faceIDs[i]) * numComponents;
+        for (size_t c = 0; c < numComponents; ++c)
+            quantityVector[idx + c] = values[i * numComponents + c];
+    }
+}
+
+void CouplingAdapter::writeQuantityOnFaces(const size_t dataID,
+                                           const std::vector<double> &values)
+{
+    assert(wasCreated_);
     assert(dataID < dataVectors_.size());
-    std::vector<double> &quantityVector = dataVectors_[dataID];
-    assert(idx < quantityVector.size());
-    quantityVector[idx] = value;
-}
-
-//void CouplingAdapter::writeVectorQuantityOnFace(const size_t dataID,
-//                                               const int faceID,
-//                                               const double* value,
-//                                               const size_t size)
-//{
-//  assert( wasCreated_ );
-//  assert( hasIndexMapper_ );
-//  assert( size == getDimensions() );
-//  if ( !hasIndexMapper_ )
-//  {
-//    throw std::runtime_error("Writing quantity using faceID, but index mapping was not created!");
-//  }
-//  const auto idx = indexMapper_.getPreciceId( faceID ) * size;
-//  assert( dataID < dataVectors_.size() );
-//  std::vector<double>& quantityVector = dataVectors_[ dataID ];
-//  assert( idx < quantityVector.size() );
-//  //quantityVector[idx] = value;
-//  std::copy_n( value, size, quantityVector[idx] );
-//}
+    const CouplingMesh &mesh = meshes_[quantityMeshes_[dataID]];
+    assert(mesh.hasIndexMapper);
+    const std::vector<int> &faceOrder = mesh.faceOrderToBufferIndex;
+    const size_t numComponents = getNumberOfComponents_(dataID);
+    assert(values.size() == faceOrder.size() * numComponents);
+
+    double *quantityVector = getQuantityData_(dataID);
+    for (size_t i = 0; i < faceOrder.size(); ++i)
+        for (size_t c = 0; c < numComponents; ++c)
+            quantityVector[faceOrder[i] * numComponents + c] =
+                values[i * numComponents + c];
+}
+
+void CouplingAdapter::readQuantityOnFaces(const size_t dataID,
+                                          const std::vector<int> &faceIDs,
+                                          std::vector<double> &values) const
+{
+    assert(wasCreated_);
+    assert(dataID < dataVectors_.size());
+    const size_t numComponents = getNumberOfComponents_(dataID);
+
+    values.resize(faceIDs.size() * numComponents);
+    const double *quantityVector = getQuantityData_(dataID);
+    for (size_t i = 0; i < faceIDs.size(); ++i) {
+        const size_t idx =
+            getBufferIndex_(dataID, faceIDs[i]) * numComponents;
+        for (size_t c = 0; c < numComponents; ++c)
+            values[i * numComponents + c] = quantityVector[idx + c];
+    }
+}
+
+void CouplingAdapter::readQuantityOnFaces(const size_t dataID,
+                                          std::vector<double> &values) const
+{
+    assert(wasCreated_);
+    assert(dataID < dataVectors_.size());
+    const CouplingMesh &mesh = meshes_[quantityMeshes_[dataID]];
+    assert(mesh.hasIndexMapper);
+    const std::vector<int> &faceOrder = mesh.faceOrderToBufferIndex;
+    const size_t numComponents = getNumberOfComponents_(dataID);
+
+    values.resize(faceOrder.size() * numComponents);
+    const double *quantityVector = getQuantityData_(dataID);
+    for (size_t i = 0; i < faceOrder.size(); ++i)
+        for (size_t c = 0; c < numComponents; ++c)
+            values[i * numComponents + c] =
+                quantityVector[faceOrder[i] * numComponents + c];
+}
+
+size_t CouplingAdapter::getBufferIndex_(const size_t dataID,
+                                        const int faceID) const
+{
+    const auto &indexMapper = meshes_[quantityMeshes_[dataID]].indexMapper;
+    if (!indexMapper.isDumuxIdMapped(faceID)) {
+        throw std::runtime_error(
+            "Accessing quantity on face that is not part of the coupling "
+            "interface!");
+    }
+    return indexMapper.getPreciceId(faceID);
+}
+
+size_t CouplingAdapter::getNumberOfComponents_(const size_t dataID) const
+{
+    assert(dataID < quantityTypes_.size());
+    return (quantityTypes_[dataID] == QuantityType::Scalar) ? 1
+                                                            : getDimensions();
+}
+
+size_t CouplingAdapter::getQuantitySize_(const size_t dataID) const
+{
+    assert(dataID < quantityMeshes_.size());
+    return meshes_[quantityMeshes_[dataID]].vertexIDs.size() *
+           getNumberOfComponents_(dataID);
+}
+
+double *CouplingAdapter::getQuantityData_(const size_t dataID)
+{
+    assert(dataID < dataVectors_.size());
+    return (externalBuffers_[dataID] != nullptr) ? externalBuffers_[dataID]
+                                                 : dataVectors_[dataID].data();
+}
+
+const double *CouplingAdapter::getQuantityData_(const size_t dataID) const
+{
+    assert(dataID < dataVectors_.size());
+    return (externalBuffers_[dataID] != nullptr) ? externalBuffers_[dataID]
+                                                 : dataVectors_[dataID].data();
+}
+
+void CouplingAdapter::bindQuantityBuffer(const size_t dataID,
+                                         double *buffer,
+                                         const size_t size)
+{
+    assert(wasCreated_);
+    assert(dataID < dataVectors_.size());
+    assert(buffer != nullptr);
+    if (size != getQuantitySize_(dataID)) {
+        throw(std::runtime_error(
+            " Error! Size of external buffer does not match quantity! "));
+    }
+    externalBuffers_[dataID] = buffer;
+    // The adapter's own buffer is not used anymore
+    std::vector<double>().swap(dataVectors_[dataID]);
+}
+
+void CouplingAdapter::unbindQuantityBuffer(const size_t dataID)
+{
+    assert(wasCreated_);
+    assert(dataID < dataVectors_.size());
+    if (externalBuffers_[dataID] == nullptr)
+        return;
+    dataVectors_[dataID].assign(
+        externalBuffers_[dataID],
+        externalBuffers_[dataID] + getQuantitySize_(dataID));
+    externalBuffers_[dataID] = nullptr;
+}
+
+bool CouplingAdapter::hasExternalBuffer(const size_t dataID) const
+{
+    assert(dataID < externalBuffers_.size());
+    return externalBuffers_[dataID] != nullptr;
+}
 
 std::vector<double> &CouplingAdapter::getQuantityVector(const size_t dataID)
 {
     assert(wasCreated_);
     assert(dataID < dataVectors_.size());
+    assert(!hasExternalBuffer(dataID));
     return dataVectors_[dataID];
 }
 
@@ -249,77 +933,392 @@ const std::vector<double> &CouplingAdapter::getQuantityVector(
     const size_t dataID) const
 {
     assert(wasCreated_);
-    return getQuantityVector(dataID);
+    assert(dataID < dataVectors_.size());
+    assert(!hasExternalBuffer(dataID));
+    return dataVectors_[dataID];
 }
 
-// void CouplingAdapter::writeScalarQuantityVector(const size_t dataID,
-//                                                 std::vector<double> &values)
-// {
-//     assert(wasCreated_);
-//     assert(dataID < dataVectors_.size());
-//     assert(dataVectors_[dataID].size() == values.size());
-//     dataVectors_[dataID] = values;
-// }
-
 void CouplingAdapter::writeQuantityVector(const size_t dataID,
-                                          std::vector<double> &values)
+                                          const std::vector<double> &values)
 {
     assert(wasCreated_);
     assert(dataID < dataVectors_.size());
-    assert(dataVectors_[dataID].size() == values.size());
-    dataVectors_[dataID] = values;
+    assert(getQuantitySize_(dataID) == values.size());
+    std::copy(values.begin(), values.end(), getQuantityData_(dataID));
 }
 
-void CouplingAdapter::writeQuantityToOtherSolver(
-    const size_t dataID,
-    const QuantityType quantity_type)
+template<QuantityType Type>
+void CouplingAdapter::writeQuantity_(const size_t dataID)
 {
     assert(wasCreated_);
+    assert(!isAdvancePending());
+    CouplingStatistics::ScopedTimer timer(statistics_,
+                                          CouplingPhase::WriteBlockData);
+    writeQuantityData_<Type>(dataID);
+}
+
+template<QuantityType Type>
+void CouplingAdapter::readQuantity_(const size_t dataID)
+{
+    assert(wasCreated_);
+    assert(!isAdvancePending());
+    CouplingStatistics::ScopedTimer timer(statistics_,
+                                          CouplingPhase::ReadBlockData);
+    readQuantityData_<Type>(dataID);
+}
+
+template<QuantityType Type>
+void CouplingAdapter::writeQuantityData_(const size_t dataID)
+{
+    assert(dataID < dataVectors_.size());
+    assert(dataID < preciceDataID_.size());
+    assert(dataID < std::numeric_limits<int>::max());
+    assert(Type == quantityTypes_[dataID]);
+    writeBlockDataToPrecice<Type>(
+        preciceDataID_[dataID], meshes_[quantityMeshes_[dataID]].vertexIDs,
+        getQuantityData_(dataID), getQuantitySize_(dataID));
+}
+
+template<QuantityType Type>
+void CouplingAdapter::readQuantityData_(const size_t dataID)
+{
     assert(dataID < dataVectors_.size());
     assert(dataID < preciceDataID_.size());
     assert(dataID < std::numeric_limits<int>::max());
-    writeBlockDataToPrecice(preciceDataID_[dataID], dataVectors_[dataID],
-                            quantity_type);
+    assert(Type == quantityTypes_[dataID]);
+    const size_t lastReadTimeWindow = lastReadTimeWindows_[dataID];
+    lastReadTimeWindows_[dataID] = timeWindowIndex_;
+    if (interpolatesInTime_[dataID] && lastReadTimeWindow != noTimeWindow_ &&
+        lastReadTimeWindow != timeWindowIndex_) {
+        // The last read of the previous time window holds the data at the
+        // start of the current one
+        const double *data = getQuantityData_(dataID);
+        std::copy(data, data + getQuantitySize_(dataID),
+                  windowStartDataVectors_[dataID].begin());
+    }
+    if (tracksChange_[dataID]) {
+        // Keep the data of the previous read, swapping avoids a copy
+        if (hasExternalBuffer(dataID))
+            std::copy(externalBuffers_[dataID],
+                      externalBuffers_[dataID] + getQuantitySize_(dataID),
+                      previousDataVectors_[dataID].begin());
+        else
+            dataVectors_[dataID].swap(previousDataVectors_[dataID]);
+    }
+    readBlockDataFromPrecice<Type>(
+        preciceDataID_[dataID], meshes_[quantityMeshes_[dataID]].vertexIDs,
+        getQuantityData_(dataID), getQuantitySize_(dataID));
+    if (tracksChange_[dataID])
+        updateQuantityChange_(dataID);
+    if (interpolatesInTime_[dataID] && lastReadTimeWindow == noTimeWindow_) {
+        // Without earlier data, the data is constant in the first window
+        const double *data = getQuantityData_(dataID);
+        std::copy(data, data + getQuantitySize_(dataID),
+                  windowStartDataVectors_[dataID].begin());
+    }
+}
+
+void CouplingAdapter::writeQuantityToOtherSolver(
+    const size_t dataID,
+    const QuantityType quantity_type)
+{
+    if (quantity_type == QuantityType::Scalar)
+        writeQuantity_<QuantityType::Scalar>(dataID);
+    else
+        writeQuantity_<QuantityType::Vector>(dataID);
 }
 
 void CouplingAdapter::readQuantityFromOtherSolver(
     const size_t dataID,
     const QuantityType quantity_type)
+{
+    if (quantity_type == QuantityType::Scalar)
+        readQuantity_<QuantityType::Scalar>(dataID);
+    else
+        readQuantity_<QuantityType::Vector>(dataID);
+}
+
+void CouplingAdapter::writeQuantityToOtherSolver(
+    const ScalarQuantityHandle quantity)
+{
+    writeQuantity_<QuantityType::Scalar>(quantity.id());
+}
+
+void CouplingAdapter::writeQuantityToOtherSolver(
+    const VectorQuantityHandle quantity)
+{
+    writeQuantity_<QuantityType::Vector>(quantity.id());
+}
+
+void CouplingAdapter::readQuantityFromOtherSolver(
+    const ScalarQuantityHandle quantity)
+{
+    readQuantity_<QuantityType::Scalar>(quantity.id());
+}
+
+void CouplingAdapter::readQuantityFromOtherSolver(
+    const VectorQuantityHandle quantity)
+{
+    readQuantity_<QuantityType::Vector>(quantity.id());
+}
+
+std::vector<size_t> CouplingAdapter::sortByMesh_(
+    const std::vector<size_t> &dataIDs) const
+{
+    std::vector<size_t> sorted(dataIDs);
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [this](const size_t a, const size_t b) {
+                         return quantityMeshes_[a] < quantityMeshes_[b];
+                     });
+    return sorted;
+}
+
+void CouplingAdapter::writeQuantitiesToOtherSolver(
+    const std::vector<size_t> &dataIDs)
+{
+    assert(wasCreated_);
+    assert(!isAdvancePending());
+    CouplingStatistics::ScopedTimer timer(statistics_,
+                                          CouplingPhase::WriteBlockData);
+    for (const auto dataID : sortByMesh_(dataIDs)) {
+        assert(dataID < quantityTypes_.size());
+        if (quantityTypes_[dataID] == QuantityType::Scalar)
+            writeQuantityData_<QuantityType::Scalar>(dataID);
+        else
+            writeQuantityData_<QuantityType::Vector>(dataID);
+    }
+}
+
+void CouplingAdapter::readQuantitiesFromOtherSolver(
+    const std::vector<size_t> &dataIDs)
+{
+    assert(wasCreated_);
+    assert(!isAdvancePending());
+    CouplingStatistics::ScopedTimer timer(statistics_,
+                                          CouplingPhase::ReadBlockData);
+    for (const auto dataID : sortByMesh_(dataIDs)) {
+        assert(dataID < quantityTypes_.size());
+        if (quantityTypes_[dataID] == QuantityType::Scalar)
+            readQuantityData_<QuantityType::Scalar>(dataID);
+        else
+            readQuantityData_<QuantityType::Vector>(dataID);
+    }
+}
+
+void CouplingAdapter::enableChangeTracking(const size_t dataID)
 {
     assert(wasCreated_);
     assert(dataID < dataVectors_.size());
-    assert(dataID < preciceDataID_.size());
-    assert(dataID < std::numeric_limits<int>::max());
-    readBlockDataFromPrecice(preciceDataID_[dataID], dataVectors_[dataID],
-                             quantity_type);
+    if (tracksChange_[dataID])
+        return;
+    tracksChange_[dataID] = true;
+    previousDataVectors_[dataID].resize(getQuantitySize_(dataID));
+}
+
+void CouplingAdapter::enableTimeInterpolation(const size_t dataID)
+{
+    assert(wasCreated_);
+    assert(dataID < dataVectors_.size());
+    if (interpolatesInTime_[dataID])
+        return;
+    interpolatesInTime_[dataID] = true;
+    const double *data = getQuantityData_(dataID);
+    windowStartDataVectors_[dataID].assign(data,
+                                           data + getQuantitySize_(dataID));
+}
+
+double CouplingAdapter::getScalarQuantityOnFace(const size_t dataID,
+                                                const int faceID,
+                                                const double relativeTime) const
+{
+    assert(wasCreated_);
+    assert(dataID < dataVectors_.size());
+    assert(meshes_[quantityMeshes_[dataID]].hasIndexMapper);
+    assert(interpolatesInTime_[dataID]);
+    assert(relativeTime >= 0. && relativeTime <= 1.);
+    const auto idx = getBufferIndex_(dataID, faceID);
+    const double end = getQuantityData_(dataID)[idx];
+    const double start = windowStartDataVectors_[dataID][idx];
+    return (1. - relativeTime) * start + relativeTime * end;
+}
+
+double CouplingAdapter::getQuantityChangeNorm(const size_t dataID) const
+{
+    assert(dataID < changeNorms_.size());
+    assert(tracksChange_[dataID]);
+    return changeNorms_[dataID];
+}
+
+double CouplingAdapter::getRelativeQuantityChange(const size_t dataID) const
+{
+    assert(dataID < changeNorms_.size());
+    assert(tracksChange_[dataID]);
+    if (dataNorms_[dataID] > 0.)
+        return changeNorms_[dataID] / dataNorms_[dataID];
+    return changeNorms_[dataID];
+}
+
+double CouplingAdapter::getInterfaceResidual() const
+{
+    double residual = -1.;
+    for (size_t i = 0; i < tracksChange_.size(); ++i)
+        if (tracksChange_[i] && hasPreviousRead_[i])
+            residual = std::max(getRelativeQuantityChange(i), residual);
+    return residual < 0. ? std::numeric_limits<double>::infinity() : residual;
+}
+
+double CouplingAdapter::getConvergenceRate() const
+{
+    const size_t n = windowResiduals_.size();
+    if (n < 2 || !std::isfinite(windowResiduals_[n - 2]) ||
+        windowResiduals_[n - 2] <= 0.)
+        return std::numeric_limits<double>::quiet_NaN();
+    return windowResiduals_[n - 1] / windowResiduals_[n - 2];
+}
+
+double CouplingAdapter::getInexactSolverTolerance(const double tolerance,
+                                                  const double maxTolerance,
+                                                  const double factor) const
+{
+    assert(tolerance <= maxTolerance);
+    // An infinite residual yields maxTolerance
+    return std::clamp(factor * getInterfaceResidual(), tolerance,
+                      maxTolerance);
+}
+
+void CouplingAdapter::enableResidualLog(const std::string &fileName)
+{
+    residualLog_.open(fileName, std::ofstream::out | std::ofstream::trunc);
+    if (!residualLog_) {
+        throw(std::runtime_error(" Error! Could not open residual log " +
+                                 fileName + "! "));
+    }
+    residualLog_ << "# timeWindow iteration residual rate\n";
+}
+
+void CouplingAdapter::recordResidual_(const bool timeWindowComplete)
+{
+    windowResiduals_.push_back(getInterfaceResidual());
+    if (residualLog_.is_open()) {
+        residualLog_ << timeWindowIndex_ << " " << windowResiduals_.size()
+                     << " " << windowResiduals_.back() << " "
+                     << getConvergenceRate() << "\n";
+        if (timeWindowComplete)
+            residualLog_.flush();
+    }
+    if (timeWindowComplete) {
+        windowResiduals_.clear();
+        // The first read of the next time window starts a new fixed-point
+        // iteration, its change to the last read is not a residual
+        std::fill(hasPreviousRead_.begin(), hasPreviousRead_.end(), false);
+    }
+}
+
+double CouplingAdapter::getRelativeQuantityChange(
+    const size_t dataID,
+    const std::vector<double> &reference) const
+{
+    assert(dataID < dataVectors_.size());
+    const size_t size = getQuantitySize_(dataID);
+    if (reference.size() != size)
+        return std::numeric_limits<double>::infinity();
+
+    double changeNorm, dataNorm;
+    computeChangeNorms_(getQuantityData_(dataID), reference.data(), size,
+                        changeNorm, dataNorm);
+    if (dataNorm > 0.)
+        return changeNorm / dataNorm;
+    return changeNorm;
+}
+
+void CouplingAdapter::updateQuantityChange_(const size_t dataID)
+{
+    double changeNorm, dataNorm;
+    computeChangeNorms_(getQuantityData_(dataID),
+                        previousDataVectors_[dataID].data(),
+                        getQuantitySize_(dataID), changeNorm, dataNorm);
+
+    // The first read has nothing to compare to
+    changeNorms_[dataID] = hasPreviousRead_[dataID]
+                               ? changeNorm
+                               : std::numeric_limits<double>::infinity();
+    dataNorms_[dataID] = dataNorm;
+    hasPreviousRead_[dataID] = true;
+}
+
+void CouplingAdapter::computeChangeNorms_(const double *data,
+                                          const double *reference,
+                                          const size_t size,
+                                          double &changeNorm,
+                                          double &dataNorm)
+{
+    changeNorm = 0.;
+    dataNorm = 0.;
+    for (size_t i = 0; i < size; ++i) {
+        const double diff = data[i] - reference[i];
+        changeNorm += diff * diff;
+        dataNorm += data[i] * data[i];
+    }
+    changeNorm = std::sqrt(changeNorm);
+    dataNorm = std::sqrt(dataNorm);
 }
 
 void CouplingAdapter::writeScalarQuantityToOtherSolver(const size_t dataID)
 {
-    writeQuantityToOtherSolver(dataID, QuantityType::Scalar);
+    writeQuantity_<QuantityType::Scalar>(dataID);
 }
 
 void CouplingAdapter::readScalarQuantityFromOtherSolver(const size_t dataID)
 {
-    readQuantityFromOtherSolver(dataID, QuantityType::Scalar);
+    readQuantity_<QuantityType::Scalar>(dataID);
+}
+
+void CouplingAdapter::writeVectorQuantityToOtherSolver(const size_t dataID)
+{
+    writeQuantity_<QuantityType::Vector>(dataID);
+}
+
+void CouplingAdapter::readVectorQuantityFromOtherSolver(const size_t dataID)
+{
+    readQuantity_<QuantityType::Vector>(dataID);
 }
 
 bool CouplingAdapter::isCoupledEntity(const int faceID) const
+{
+    return isCoupledEntity(0, faceID);
+}
+
+bool CouplingAdapter::isCoupledEntity(const size_t meshIndex,
+                                      const int faceID) const
 {
     assert(wasCreated_);
-    return indexMapper_.isDumuxIdMapped(faceID);
+    assert(meshIndex < meshes_.size());
+    return meshes_[meshIndex].indexMapper.isDumuxIdMapped(faceID);
 }
 
 size_t CouplingAdapter::getIdFromName(const std::string &dataName) const
 {
     assert(wasCreated_);
-    const auto it = std::find(dataNames_.begin(), dataNames_.end(), dataName);
-    if (it == dataNames_.end()) {
+    const auto it = quantityIDs_.find(dataName);
+    if (it == quantityIDs_.end()) {
         throw(std::runtime_error(" Error! Name of data not found! "));
     }
-    const auto idx = std::distance(dataNames_.begin(), it);
-    assert(idx > -1);
-    return size_t(idx);
+    return it->second.front();
+}
+
+size_t CouplingAdapter::getIdFromName(const size_t meshIndex,
+                                      const std::string &dataName) const
+{
+    assert(wasCreated_);
+    const auto it = quantityIDs_.find(dataName);
+    if (it != quantityIDs_.end()) {
+        // At most one quantity of the name per mesh
+        for (const auto id : it->second) {
+            if (quantityMeshes_[id] == meshIndex)
+                return id;
+        }
+    }
+    throw(std::runtime_error(" Error! Name of data not found! "));
 }
 
 std::string CouplingAdapter::getNameFromId(const size_t dataID) const
@@ -331,50 +1330,59 @@ std::string CouplingAdapter::getNameFromId(const size_t dataID) const
 
 void CouplingAdapter::print(std::ostream &os)
 {
-    os << indexMapper_;
+    for (const auto &mesh : meshes_) {
+        os << "Mesh " << mesh.name << "\n";
+        os << mesh.indexMapper;
+    }
 }
 
 bool CouplingAdapter::checkIfActionIsRequired(const std::string &condition)
 {
     assert(wasCreated_);
+    assert(!isAdvancePending());
     return precice_->isActionRequired(condition);
 }
 
 void CouplingAdapter::actionIsFulfilled(const std::string &condition)
 {
     assert(wasCreated_);
+    assert(!isAdvancePending());
     precice_->markActionFulfilled(condition);
 }
 
-void CouplingAdapter::readBlockDataFromPrecice(const int dataID,
-                                               std::vector<double> &data,
-                                               const QuantityType quantity_type)
+template<QuantityType Type>
+void CouplingAdapter::readBlockDataFromPrecice(
+    const int dataID,
+    const std::vector<int> &vertexIDs,
+    double *data,
+    const size_t size)
 {
-    assert(wasCreated_);
-    if (quantity_type == QuantityType::Scalar) {
-        assert(vertexIDs_.size() == data.size());
-        precice_->readBlockScalarData(dataID, vertexIDs_.size(),
-                                      vertexIDs_.data(), data.data());
+    if constexpr (Type == QuantityType::Scalar) {
+        assert(vertexIDs.size() == size);
+        precice_->readBlockScalarData(dataID, vertexIDs.size(),
+                                      vertexIDs.data(), data);
     } else {
-        assert(vertexIDs_.size() * getDimensions() == data.size());
-        precice_->readBlockVectorData(dataID, vertexIDs_.size(),
-                                      vertexIDs_.data(), data.data());
+        assert(vertexIDs.size() * getDimensions() == size);
+        precice_->readBlockVectorData(dataID, vertexIDs.size(),
+                                      vertexIDs.data(), data);
     }
 }
 
-void CouplingAdapter::writeBlockDataToPrecice(const int dataID,
-                                              std::vector<double> &data,
-                                              const QuantityType quantity_type)
+template<QuantityType Type>
+void CouplingAdapter::writeBlockDataToPrecice(
+    const int dataID,
+    const std::vector<int> &vertexIDs,
+    const double *data,
+    const size_t size)
 {
-    assert(wasCreated_);
-    if (quantity_type == QuantityType::Scalar) {
-        assert(vertexIDs_.size() == data.size());
-        precice_->writeBlockScalarData(dataID, vertexIDs_.size(),
-                                       vertexIDs_.data(), data.data());
+    if constexpr (Type == QuantityType::Scalar) {
+        assert(vertexIDs.size() == size);
+        precice_->writeBlockScalarData(dataID, vertexIDs.size(),
+                                       vertexIDs.data(), data);
     } else {
-        assert(vertexIDs_.size() * getDimensions() == data.size());
-        precice_->writeBlockVectorData(dataID, vertexIDs_.size(),
-                                       vertexIDs_.data(), data.data());
+        assert(vertexIDs.size() * getDimensions() == size);
+        precice_->writeBlockVectorData(dataID, vertexIDs.size(),
+                                       vertexIDs.data(), data);
     }
 }
 
@@ -394,6 +1402,7 @@ void CouplingAdapter::announceInitialDataWritten()
 bool CouplingAdapter::hasToReadIterationCheckpoint()
 {
     assert(wasCreated_);
+    checkpointReadStart_ = CouplingStatistics::Clock::now();
     return checkIfActionIsRequired(
         precice::constants::actionReadIterationCheckpoint());
 }
@@ -402,11 +1411,14 @@ void CouplingAdapter::announceIterationCheckpointRead()
 {
     assert(wasCreated_);
     actionIsFulfilled(precice::constants::actionReadIterationCheckpoint());
+    statistics_.addMeasurement(CouplingPhase::ReadCheckpoint,
+                               checkpointReadStart_);
 }
 
 bool CouplingAdapter::hasToWriteIterationCheckpoint()
 {
     assert(wasCreated_);
+    checkpointWriteStart_ = CouplingStatistics::Clock::now();
     return checkIfActionIsRequired(
         precice::constants::actionWriteIterationCheckpoint());
 }
@@ -415,6 +1427,113 @@ void CouplingAdapter::announceIterationCheckpointWritten()
 {
     assert(wasCreated_);
     actionIsFulfilled(precice::constants::actionWriteIterationCheckpoint());
+    statistics_.addMeasurement(CouplingPhase::WriteCheckpoint,
+                               checkpointWriteStart_);
+}
+
+void CouplingAdapter::enableSnapshots(const std::string &fileName,
+                                      const size_t interval)
+{
+    assert(interval > 0);
+    snapshotFileName_ = fileName;
+    snapshotInterval_ = interval;
+}
+
+bool CouplingAdapter::hasToWriteSnapshot() const
+{
+    return !snapshotFileName_.empty() && timeWindowIndex_ > 0 &&
+           timeWindowIndex_ % snapshotInterval_ == 0;
+}
+
+void CouplingAdapter::writeSnapshot(const std::vector<double> &solverState)
+{
+    assert(!snapshotFileName_.empty());
+    if (pendingSnapshot_.valid())
+        pendingSnapshot_.get();
+
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->timeWindowIndex = timeWindowIndex_;
+    snapshot->time = time_;
+    for (const auto &mesh : meshes_) {
+        snapshot->meshNames.push_back(mesh.name);
+        snapshot->meshBufferIndices.push_back(mesh.faceOrderToBufferIndex);
+    }
+    snapshot->dataNames = dataNames_;
+    snapshot->dataMeshes.assign(quantityMeshes_.begin(), quantityMeshes_.end());
+    for (size_t dataID = 0; dataID < numberOfQuantities(); ++dataID) {
+        const double *data = getQuantityData_(dataID);
+        snapshot->dataVectors.emplace_back(data,
+                                           data + getQuantitySize_(dataID));
+    }
+    snapshot->solverState = solverState;
+
+    // The snapshot before the last one is kept: if the run is interrupted
+    // while the participants write their snapshots, only the earlier one
+    // may have been written by both
+    const std::string obsoleteFileName =
+        timeWindowIndex_ > 2 * snapshotInterval_
+            ? snapshotFile(snapshotFileName_,
+                           timeWindowIndex_ - 2 * snapshotInterval_)
+            : "";
+    pendingSnapshot_ = std::async(
+        std::launch::async,
+        [snapshot, obsoleteFileName,
+         fileName = snapshotFile(snapshotFileName_, timeWindowIndex_)]() {
+            writeSnapshotFile(*snapshot, fileName);
+            if (!obsoleteFileName.empty())
+                std::remove(obsoleteFileName.c_str());
+        });
+}
+
+void CouplingAdapter::readSnapshot(std::vector<double> &solverState,
+                                   const size_t timeWindow)
+{
+    assert(!snapshotFileName_.empty());
+    const std::string fileName = snapshotFile(snapshotFileName_, timeWindow);
+    std::ifstream ifs(fileName, std::ios::binary);
+    if (!ifs)
+        throw std::runtime_error("The snapshot " + fileName +
+                                 " does not exist!");
+
+    Snapshot snapshot;
+    if (!readSnapshotFile(snapshot, ifs))
+        throw std::runtime_error("The snapshot " + fileName + " is invalid!");
+    if (snapshot.timeWindowIndex != timeWindow)
+        throw std::runtime_error("The snapshot " + fileName +
+                                 " was written after time window " +
+                                 std::to_string(snapshot.timeWindowIndex) +
+                                 "!");
+
+    // The buffers are only meaningful for the same meshes and quantities
+    bool matches = snapshot.meshNames.size() == meshes_.size() &&
+                   snapshot.dataNames == dataNames_;
+    for (size_t i = 0; matches && i < meshes_.size(); ++i)
+        matches = snapshot.meshNames[i] == meshes_[i].name &&
+                  snapshot.meshBufferIndices[i] ==
+                      meshes_[i].faceOrderToBufferIndex;
+    for (size_t dataID = 0; matches && dataID < numberOfQuantities();
+         ++dataID)
+        matches = snapshot.dataMeshes[dataID] == quantityMeshes_[dataID] &&
+                  snapshot.dataVectors[dataID].size() ==
+                      getQuantitySize_(dataID);
+    if (!matches)
+        throw std::runtime_error("The snapshot " + fileName +
+                                 " does not match the coupling meshes and"
+                                 " quantities!");
+
+    timeWindowIndex_ = snapshot.timeWindowIndex;
+    time_ = snapshot.time;
+    windowTime_ = 0.;
+    for (size_t dataID = 0; dataID < numberOfQuantities(); ++dataID) {
+        std::copy(snapshot.dataVectors[dataID].begin(),
+                  snapshot.dataVectors[dataID].end(),
+                  getQuantityData_(dataID));
+        // The buffers hold the last read of the previous time window, i.e.
+        // the data at the start of the current one
+        lastReadTimeWindows_[dataID] = timeWindowIndex_ - 1;
+        hasPreviousRead_[dataID] = false;
+    }
+    solverState = std::move(snapshot.solverState);
 }
 
 CouplingAdapter::~CouplingAdapter() {}
@@ -1,9 +1,20 @@
 #ifndef PRECICEWRAPPER_HH
 #define PRECICEWRAPPER_HH
 
+#include <cassert>
+#include <fstream>
+#include <future>
+#include <limits>
 #include <ostream>
 #include <precice/SolverInterface.hpp>
+#include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+
+#include "couplingstatistics.hh"
 
 #include "dumuxpreciceindexmapper.hh"
 
@@ -15,6 +26,90 @@ namespace Dumux::Precice
 {
 enum class QuantityType { Scalar, Vector };
 
+/*!
+ * @brief Order in which the vertices of a coupling mesh are passed to preCICE.
+ *
+ * - `Input`: Order of the coordinates passed to setMesh.
+ * - `Morton`: Order along a Morton (Z-order) space-filling curve. Vertices
+ *   close in space are close in memory, which improves the locality of
+ *   preCICE's data mapping and of the adapter's block reads and writes on
+ *   unstructured grids.
+ */
+enum class VertexOrdering { Input, Morton };
+
+/*!
+ * @brief Typed handle of a quantity announced to the coupling adapter.
+ *
+ * The kind of the quantity (scalar or vector) is part of the handle's type.
+ * Functions taking a handle resolve the kind at compile time, and passing
+ * a vector handle where a scalar quantity is expected (or vice versa) does
+ * not compile. The handle converts implicitly to the numeric identifier
+ * accepted by all other functions of the adapter.
+ *
+ * @tparam Type Kind of the quantity.
+ */
+template<QuantityType Type>
+class QuantityHandle
+{
+public:
+    //! Kind of the quantity.
+    static constexpr QuantityType type = Type;
+
+    //! Creates an invalid handle.
+    constexpr QuantityHandle() = default;
+    /*!
+     * @brief Creates a handle from a numeric identifier.
+     *
+     * @param[in] id Identifier of the quantity as returned by announceQuantity.
+     */
+    constexpr explicit QuantityHandle(const size_t id) : id_(id) {}
+
+    /*!
+     * @brief Gets the numeric identifier of the quantity.
+     *
+     * @return size_t Identifier of the quantity.
+     */
+    constexpr size_t id() const { return id_; }
+    constexpr operator size_t() const { return id_; }
+
+private:
+    //! Identifier of the quantity.
+    size_t id_ = size_t(-1);
+};
+
+//! Handle of a scalar quantity.
+using ScalarQuantityHandle = QuantityHandle<QuantityType::Scalar>;
+//! Handle of a vector quantity.
+using VectorQuantityHandle = QuantityHandle<QuantityType::Vector>;
+
+/*!
+ * @brief Memory held by the coupling adapter.
+ *
+ * Sizes are the allocated capacities of the adapter's containers. The
+ * memory of preCICE and of buffers bound via bindQuantityBuffer is not
+ * included.
+ */
+struct MemoryUsage {
+    //! Memory held by one quantity or structure.
+    struct Entry {
+        //! Name of the quantity or structure.
+        std::string name;
+        //! Number of bytes.
+        size_t bytes;
+    };
+    //! Buffers of every quantity, including the ones kept for time
+    //! interpolation and change tracking.
+    std::vector<Entry> quantities;
+    //! Vertex identifiers and index mapping of every mesh.
+    std::vector<Entry> structures;
+    /*!
+     * @brief Gets the memory of all quantities and structures.
+     *
+     * @return size_t Number of bytes.
+     */
+    size_t total() const;
+};
+
 /*!
  * @brief A DuMuX-preCICE coupling adapter class
  *
@@ -23,7 +118,13 @@ enum class QuantityType { Scalar, Vector };
  * easy-to-use interface that is reasonably close to the coupling
  * interface for monolithic couplings that is integrated into DuMuX.
  *
- * \note The coupling adapter is currently implemented as a Singleton.
+ * Every instance wraps its own preCICE participant. Instances are created
+ * by the driver and handed to the objects that exchange data, e.g. the
+ * problem classes. Several instances may coexist in one process as long
+ * as each of them is announced as a different participant.
+ *
+ * \note getInstance provides a process-wide instance for code that still
+ *       relies on the former Singleton interface.
  *
  */
 class CouplingAdapter
@@ -33,8 +134,6 @@ private:
     bool wasCreated_;
     //! Pointer to preCICE instance
     std::unique_ptr<precice::SolverInterface> precice_;
-    //! Constructor
-    CouplingAdapter();
     /*!
      * @brief Checks whether an action predefined by preCICE
      *        needs to be carried out.
@@ -53,21 +152,71 @@ private:
     /*!
      * @brief Reads full block of data from preCICE.
      *
+     * @tparam Type Type (Scalar or Vector) of the quantity.
      * @param[in] dataID Identifier of dataset to read.
-     * @param[out] data Vector to store the read data to.
+     * @param[in] vertexIDs preCICE identifiers of the vertices of the mesh.
+     * @param[out] data Buffer to store the read data to.
+     * @param[in] size Size of the buffer.
      */
+    template<QuantityType Type>
     void readBlockDataFromPrecice(const int dataID,
-                                  std::vector<double> &data,
-                                  const QuantityType quantity_type);
+                                  const std::vector<int> &vertexIDs,
+                                  double *data,
+                                  const size_t size);
     /*!
      * @brief Writes full block of data to preCICE.
      *
+     * @tparam Type Type (Scalar or Vector) of the quantity.
      * @param[in] dataID Identifier of dataset to read.
-     * @param[in] data Vector containing data to write into preCICE's buffer.
+     * @param[in] vertexIDs preCICE identifiers of the vertices of the mesh.
+     * @param[in] data Buffer containing data to write into preCICE's buffer.
+     * @param[in] size Size of the buffer.
      */
+    template<QuantityType Type>
     void writeBlockDataToPrecice(const int dataID,
-                                 std::vector<double> &data,
-                                 const QuantityType quantity_type);
+                                 const std::vector<int> &vertexIDs,
+                                 const double *data,
+                                 const size_t size);
+    /*!
+     * @brief Reads a quantity from preCICE into the adapter's buffer.
+     *
+     * @tparam Type Type (Scalar or Vector) of the quantity.
+     * @param[in] dataID Identifier of the quantity.
+     */
+    template<QuantityType Type>
+    void readQuantity_(const size_t dataID);
+    /*!
+     * @brief Writes a quantity from the adapter's buffer to preCICE.
+     *
+     * @tparam Type Type (Scalar or Vector) of the quantity.
+     * @param[in] dataID Identifier of the quantity.
+     */
+    template<QuantityType Type>
+    void writeQuantity_(const size_t dataID);
+    /*!
+     * @brief Reads a quantity without timing the read.
+     *
+     * @tparam Type Type (Scalar or Vector) of the quantity.
+     * @param[in] dataID Identifier of the quantity.
+     */
+    template<QuantityType Type>
+    void readQuantityData_(const size_t dataID);
+    /*!
+     * @brief Writes a quantity without timing the write.
+     *
+     * @tparam Type Type (Scalar or Vector) of the quantity.
+     * @param[in] dataID Identifier of the quantity.
+     */
+    template<QuantityType Type>
+    void writeQuantityData_(const size_t dataID);
+    /*!
+     * @brief Sorts quantities by the mesh they are defined on.
+     *
+     * @param[in] dataIDs Identifiers of the quantities.
+     * @return std::vector<size_t> The identifiers, quantities on the same
+     *         mesh are consecutive and keep their relative order.
+     */
+    std::vector<size_t> sortByMesh_(const std::vector<size_t> &dataIDs) const;
     /*!
      * @brief Gives the number of quantities/datasets defined on coupling interface.
      *
@@ -78,26 +227,201 @@ private:
     bool meshWasCreated_;
     //! True if precice::SolverInterface.initialize() has been called.
     bool preciceWasInitialized_;
-    //! True if instance owns an instance of DumuxPreciceIndexMapper.
-    bool hasIndexMapper_;
-    //! Stores identifier of the coupling mesh provided by preCICE.
-    int meshID_;
     //! Time step size.
     double timeStepSize_;
     //! Vector of names of data exchanged over coupling interface.
     std::vector<std::string> dataNames_;
+    //! Identifiers of the quantities of a given name, sorted by mesh index.
+    std::unordered_map<std::string, std::vector<size_t> > quantityIDs_;
     //! Vector of identifiers of data exchanged over coupling interface.
     std::vector<int> preciceDataID_;
     //! Vector storing data vectors of the data exchanged over the coupling interface.
     std::vector<std::vector<double> > dataVectors_;
-    //! Vector of identifiers of the vertices of the coupling mesh.
-    std::vector<int> vertexIDs_;  //should be size_t
+    //! Vector of buffers provided by the user, nullptr if the adapter's own buffer is used.
+    std::vector<double *> externalBuffers_;
+    //! Vector of types (Scalar or Vector) of the data exchanged over coupling interface.
+    std::vector<QuantityType> quantityTypes_;
+    /*!
+     * @brief Coupling mesh defined by this solver.
+     *
+     */
+    struct CouplingMesh {
+        //! Name of the mesh in the preCICE configuration.
+        std::string name;
+        //! Identifier of the mesh provided by preCICE.
+        int preciceID = 0;
+        //! Identifiers of the vertices of the mesh.
+        std::vector<int> vertexIDs;  //should be size_t
+        //! Number of points passed to setMesh.
+        size_t numberOfInputPoints = 0;
+        /*!
+         * @brief Position in vertexIDs of every point passed to setMesh.
+         *
+         * Empty if the points were passed to preCICE unchanged.
+         */
+        std::vector<size_t> inputToVertex;
+        //! True if the index mapping of the mesh has been created.
+        bool hasIndexMapper = false;
+        /*!
+         * @brief Instance of DumuxPreciceIndexMapper that translates between
+         *        DuMuX' identifiers of vertices and preCICE's identifiers.
+         *
+         */
+        Internal::DumuxPreciceIndexMapper<int> indexMapper;
+        /*!
+         * @brief Buffer positions of the faces passed to createIndexMapping,
+         *        in the order they were passed.
+         */
+        std::vector<int> faceOrderToBufferIndex;
+        //! True if the data only needed to create the index mapping was released.
+        bool setupDataWasReleased = false;
+    };
+    //! Vector of coupling meshes, indexed by the mesh index returned by setMesh.
+    std::vector<CouplingMesh> meshes_;
+    //! Vector of mesh indices the data exchanged over the coupling interface lives on.
+    std::vector<size_t> quantityMeshes_;
+    //! Vector of data of the previous read of quantities whose change is tracked.
+    std::vector<std::vector<double> > previousDataVectors_;
+    //! Vector of flags whether the change of a quantity between two reads is computed.
+    std::vector<bool> tracksChange_;
+    //! Vector of flags whether a tracked quantity has been read before.
+    std::vector<bool> hasPreviousRead_;
+    //! Vector of norms of the change of the quantities in the last read.
+    std::vector<double> changeNorms_;
+    //! Vector of norms of the data of the quantities in the last read.
+    std::vector<double> dataNorms_;
+    //! Interface residuals of the completed coupling iterations of the current time window.
+    std::vector<double> windowResiduals_;
+    //! Log of the interface residuals, not open if logging is not enabled.
+    std::ofstream residualLog_;
+    /*!
+     * @brief Computes the change of a tracked quantity after it has been read.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     */
+    void updateQuantityChange_(const size_t dataID);
+    /*!
+     * @brief Computes the norm of the change between two buffers.
+     *
+     * @param[in] data Current data.
+     * @param[in] reference Data the change is computed to.
+     * @param[in] size Number of values in both buffers.
+     * @param[out] changeNorm Euclidean norm of the change.
+     * @param[out] dataNorm Euclidean norm of the current data.
+     */
+    static void computeChangeNorms_(const double *data,
+                                    const double *reference,
+                                    const size_t size,
+                                    double &changeNorm,
+                                    double &dataNorm);
+    //! True if startAdvance runs preCICE's advance on a separate thread.
+    bool asynchronousAdvance_;
+    //! Result of the advance started by startAdvance, invalid if none is pending.
+    std::future<double> pendingAdvance_;
+    //! Vector of data at the start of the current time window of quantities interpolated in time.
+    std::vector<std::vector<double> > windowStartDataVectors_;
+    //! Vector of flags whether a quantity is interpolated in time.
+    std::vector<bool> interpolatesInTime_;
+    //! Vector of indices of the time window each quantity was last read in.
+    std::vector<size_t> lastReadTimeWindows_;
+    //! Marks a quantity that has not been read yet.
+    static constexpr size_t noTimeWindow_ = std::numeric_limits<size_t>::max();
+    //! Number of time windows completed so far.
+    size_t timeWindowIndex_;
+    //! Simulation time at the end of the completed time windows.
+    double time_;
+    //! Time advanced within the current time window.
+    double windowTime_;
+    //! Time step length passed to startAdvance.
+    double pendingTimeStepLength_;
+    /*!
+     * @brief Records a completed coupling iteration after preCICE's advance.
+     *
+     * @param[in] computedTimeStepLength Time step length of the iteration.
+     */
+    void completeIteration_(const double computedTimeStepLength);
+    /*!
+     * @brief Records the interface residual of a completed coupling iteration.
+     *
+     * Only called at the end of a coupling iteration, i.e. if the time window
+     * is complete or has to be repeated, not after a substep.
+     *
+     * @param[in] timeWindowComplete True if the iteration completed the
+     *            time window.
+     */
+    void recordResidual_(const bool timeWindowComplete);
+    /*!
+     * @brief Calls preCICE's advance and records its timing.
+     *
+     * @param[in] computedTimeStepLength Time step length of the current simulation step.
+     * @return double Maximum time step length for successive time steps.
+     */
+    double advancePrecice_(const double computedTimeStepLength);
+    //! Timings and call counts of the coupling phases.
+    CouplingStatistics statistics_;
+    //! True if a summary of the statistics is written at finalize.
+    bool writeStatisticsSummary_;
+    //! File the statistics are written to as JSON at finalize, may be empty.
+    std::string statisticsFileName_;
+    //! File snapshots are written to, empty if snapshots are not enabled.
+    std::string snapshotFileName_;
+    //! Number of time windows between two snapshots.
+    size_t snapshotInterval_;
+    //! Snapshot being written on a separate thread, invalid if none is pending.
+    std::future<void> pendingSnapshot_;
+    //! Time a checkpoint was requested by hasToWriteIterationCheckpoint.
+    CouplingStatistics::Clock::time_point checkpointWriteStart_;
+    //! Time a checkpoint was requested by hasToReadIterationCheckpoint.
+    CouplingStatistics::Clock::time_point checkpointReadStart_;
+    /*!
+     * @brief Resolves the buffer position of the given face.
+     *
+     * Throws if the face is not part of the mesh the quantity lives on.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     * @param[in] faceID Identifier of the face according to DuMuX' numbering.
+     * @return size_t Buffer position of the face.
+     */
+    size_t getBufferIndex_(const size_t dataID, const int faceID) const;
+    /*!
+     * @brief Get the number of components of a quantity.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     * @return size_t 1 for scalar quantities, number of dimensions for vector quantities.
+     */
+    size_t getNumberOfComponents_(const size_t dataID) const;
+    /*!
+     * @brief Get the number of values stored for a quantity.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     * @return size_t Number of vertices times number of components.
+     */
+    size_t getQuantitySize_(const size_t dataID) const;
+    /*!
+     * @brief Creates the handle of a quantity after checking its type.
+     *
+     * @tparam Type Expected type (Scalar or Vector) of the quantity.
+     * @param[in] dataID Identifier of the quantity.
+     * @return QuantityHandle<Type> Handle of the quantity.
+     */
+    template<QuantityType Type>
+    QuantityHandle<Type> makeHandle_(const size_t dataID) const
+    {
+        assert(dataID < quantityTypes_.size());
+        if (quantityTypes_[dataID] != Type)
+            throw(std::runtime_error(
+                " Error! Quantity " + dataNames_[dataID] +
+                " has a different type than the requested handle! "));
+        return QuantityHandle<Type>(dataID);
+    }
     /*!
-     * @brief Instance of DumuxPreciceIndexMapper that translates between
-     *        DuMuX' identifiers of vertices and preCICE's identifiers.
+     * @brief Get the buffer of a quantity.
      *
+     * @param[in] dataID Identifier of the quantity.
+     * @return double* External buffer if one was bound, otherwise the adapter's buffer.
      */
-    Internal::DumuxPreciceIndexMapper<int> indexMapper_;
+    double *getQuantityData_(const size_t dataID);
+    const double *getQuantityData_(const size_t dataID) const;
     /*!
      * @brief Get the of quantities exchanged.
      *
@@ -106,20 +430,25 @@ private:
     size_t getNumberOfQuantities() const { return dataNames_.size(); }
     //! Number of expected quantities on the coupling interface.
     static constexpr size_t reserveSize_ = 4;
+
+public:
+    //! Constructor
+    CouplingAdapter();
     /*!
      * @brief Destroy the CouplingAdapter object
      *
      */
     ~CouplingAdapter();
-
-public:
     CouplingAdapter(const CouplingAdapter &) = delete;
     void operator=(const CouplingAdapter &) = delete;
 
     /*!
-     * @brief Get the instance of the CouplingAdapter
+     * @brief Get the process-wide instance of the CouplingAdapter
      *
-     * @return CouplingAdapter& Reference to current instance of the CouplingAdapter
+     * \note Kept for compatibility with code written against the former
+     *       Singleton interface. New code should create its own instance.
+     *
+     * @return CouplingAdapter& Reference to the process-wide instance of the CouplingAdapter
      */
     static CouplingAdapter &getInstance();
     /*!
@@ -134,6 +463,23 @@ public:
                         const std::string configurationFileName,
                         const int rank,
                         const int size);
+    /*!
+     * @brief Announces the DuMuX solver using a custom MPI communicator.
+     *
+     * Allows several participants to live in the same MPI job, each one
+     * using its own communicator instead of MPI_COMM_WORLD.
+     *
+     * @param[in] name Name of the DuMuX solver.
+     * @param[in] configurationFileName  Path and file name to preCICE configuration file.
+     * @param[in] rank Rank of the current process within the communicator.
+     * @param[in] size Total number of processes within the communicator.
+     * @param[in] communicator Pointer to the MPI communicator (MPI_Comm*) of the solver.
+     */
+    void announceSolver(const std::string &name,
+                        const std::string configurationFileName,
+                        const int rank,
+                        const int size,
+                        void *communicator);
     /*!
      * @brief Announces an additional quantity on the coupling interface.
      *
@@ -146,6 +492,19 @@ public:
      */
     size_t announceQuantity(const std::string &name,
                             const QuantityType quantity_type);
+    /*!
+     * @brief Announces an additional quantity on the given coupling mesh.
+     *
+     * @param[in] meshIndex Index of the mesh as returned by setMesh.
+     * @param[in] name Name of the quantity.
+     * @param[in] quantity_type Type (Scalar or Vector) of the quantity
+     * @return size_t Number of currently announced quantities.
+     *
+     * \note Quantities on different meshes may share the same name.
+     */
+    size_t announceQuantity(const size_t meshIndex,
+                            const std::string &name,
+                            const QuantityType quantity_type);
 
     /*!
      * @brief Announces an additional scalar quantity on the coupling interface.
@@ -154,9 +513,18 @@ public:
      * data structures are initilized to store information about the quantity.
      *
      * @param[in] name Name of the scalar quantity.
-     * @return size_t Number of currently announced quantities.
+     * @return ScalarQuantityHandle Handle of the quantity.
+     */
+    ScalarQuantityHandle announceScalarQuantity(const std::string &name);
+    /*!
+     * @brief Announces an additional scalar quantity on the given coupling mesh.
+     *
+     * @param[in] meshIndex Index of the mesh as returned by setMesh.
+     * @param[in] name Name of the scalar quantity.
+     * @return ScalarQuantityHandle Handle of the quantity.
      */
-    size_t announceScalarQuantity(const std::string &name);
+    ScalarQuantityHandle announceScalarQuantity(const size_t meshIndex,
+                                                const std::string &name);
     /*!
      * @brief Announces an additional vector quantity on the coupling interface.
      *
@@ -164,9 +532,18 @@ public:
      * data structures are initilized to store information about the quantity.
      *
      * @param[in] name Name of the vector quantity.
-     * @return size_t Number of currently announced quantities.
+     * @return VectorQuantityHandle Handle of the quantity.
      */
-    size_t announceVectorQuantity(const std::string &name);
+    VectorQuantityHandle announceVectorQuantity(const std::string &name);
+    /*!
+     * @brief Announces an additional vector quantity on the given coupling mesh.
+     *
+     * @param[in] meshIndex Index of the mesh as returned by setMesh.
+     * @param[in] name Name of the vector quantity.
+     * @return VectorQuantityHandle Handle of the quantity.
+     */
+    VectorQuantityHandle announceVectorQuantity(const size_t meshIndex,
+                                                const std::string &name);
     /*!
      * @brief Get the number of spatial dimensions
      *
@@ -206,6 +583,7 @@ public:
      * @param[in] meshName Name of the mesh.
      * @param[in] numPoints Number of points/vertices.
      * @param[in] coordinates Coordinates of the points.
+     * @return size_t Index of the mesh, used to address it in the mesh-aware overloads.
      *
      * \note The coordinates need to be stored consecutively
      *       according to their spatial coordinates as.\n
@@ -213,10 +591,41 @@ public:
      *       [x_1, y_1, x_2, y_2,...x_numPoints, y_numPoints]\n
      *       Example 3D:\n
      *       [x_1, y_1, z_1, x_2, y_2, z_2,...x_numPoints, y_numPoints, z_numPoints]
+     *
+     * \note setMesh may be called several times before initialize to couple
+     *       over more than one mesh, e.g. several interface patches. The first
+     *       mesh has index 0. Functions without a mesh index refer to it.
      */
-    void setMesh(const std::string &meshName,
-                 const size_t numPoints,
-                 std::vector<double> &coordinates);
+    size_t setMesh(const std::string &meshName,
+                   const size_t numPoints,
+                   std::vector<double> &coordinates);
+    /*!
+     * @brief Adds mesh for coupling of solvers after reordering and
+     *        optionally deduplicating its points.
+     *
+     * The permutation is hidden from the caller: createIndexMapping and the
+     * functions taking values in face order expect the points in the order
+     * they were passed here.
+     *
+     * @param[in] meshName Name of the mesh.
+     * @param[in] numPoints Number of points/vertices.
+     * @param[in] coordinates Coordinates of the points.
+     * @param[in] ordering Order of the vertices passed to preCICE.
+     * @param[in] deduplicate If true, coincident points are passed to preCICE
+     *            only once and their faces share the vertex.
+     * @param[in] tolerance Points closer than the tolerance in every
+     *            coordinate are coincident.
+     * @return size_t Index of the mesh, used to address it in the mesh-aware overloads.
+     *
+     * \note Faces sharing a vertex share the values of all quantities. When
+     *       writing, the value of the face written last is kept.
+     */
+    size_t setMesh(const std::string &meshName,
+                   const size_t numPoints,
+                   std::vector<double> &coordinates,
+                   const VertexOrdering ordering,
+                   const bool deduplicate = false,
+                   const double tolerance = 1e-12);
     /*!
      * @brief Initializes the coupling
      *
@@ -231,11 +640,27 @@ public:
      *        vertex identifiers.
      *
      * @param[in] dumuxFaceIDs Vector containing the face identifiers on the coupling interface.
+     * @param[in] mappingType Storage layout of the mapping. `Dense` gives O(1) lookups
+     *            and should be preferred unless the face identifiers are very sparse.
      *
      * \note The order of the face identifiers must be correspond to the order of coordinates
      *       passed in setMesh.
      */
-    void createIndexMapping(const std::vector<int> &dumuxFaceIDs);
+    void createIndexMapping(
+        const std::vector<int> &dumuxFaceIDs,
+        const IndexMappingType mappingType = IndexMappingType::Dense);
+    /*!
+     * @brief Creates mapping between DuMuX' face identifiers and preCICE's
+     *        vertex identifiers of the given coupling mesh.
+     *
+     * @param[in] meshIndex Index of the mesh as returned by setMesh.
+     * @param[in] dumuxFaceIDs Vector containing the face identifiers on the mesh.
+     * @param[in] mappingType Storage layout of the mapping.
+     */
+    void createIndexMapping(
+        const size_t meshIndex,
+        const std::vector<int> &dumuxFaceIDs,
+        const IndexMappingType mappingType = IndexMappingType::Dense);
     /*!
      * @brief Sets the coupling mesh and initializes coupling.
      *
@@ -273,6 +698,46 @@ public:
      * @return double Maximum time step length for successive time steps.
      */
     double advance(const double computedTimeStepLength);
+    /*!
+     * @brief Enables running preCICE's advance on a separate thread.
+     *
+     * If enabled, startAdvance returns immediately and the exchange with
+     * the other participant overlaps with the work the solver does until
+     * finishAdvance is called. Otherwise, advance is only carried out when
+     * finishAdvance is called and the behavior equals calling advance.
+     *
+     * \note preCICE is then called from a thread different from the main
+     *       thread. If preCICE or the solver communicate via MPI while the
+     *       advance is pending, MPI has to be initialized with at least
+     *       MPI_THREAD_SERIALIZED (MPI_THREAD_MULTIPLE if both do).
+     *
+     * @param[in] enable True to run advance asynchronously.
+     */
+    void setAsynchronousAdvance(const bool enable);
+    /*!
+     * @brief Starts advancing the coupling by the given time step length.
+     *
+     * Until finishAdvance has been called, only work that does not depend
+     * on the exchange may be carried out. In particular, no data may be
+     * read from or written to preCICE and no actions may be queried. The
+     * adapter's own buffers may be accessed.
+     *
+     * @param[in] computedTimeStepLength Time step lengths of the current simulation step.
+     */
+    void startAdvance(const double computedTimeStepLength);
+    /*!
+     * @brief Waits for the advance started by startAdvance to complete.
+     *
+     * @return double Maximum time step length for successive time steps.
+     */
+    double finishAdvance();
+    /*!
+     * @brief Checks whether an advance started by startAdvance has not been finished yet.
+     *
+     * @return true finishAdvance still needs to be called.
+     * @return false No advance is pending.
+     */
+    bool isAdvancePending() const { return pendingAdvance_.valid(); }
     /*!
      * @brief Checks whether the coupling is still ongoing.
      *
@@ -286,6 +751,131 @@ public:
      * @return size_t Number of vertices on the coupling interface.
      */
     size_t getNumberOfVertices();
+    /*!
+     * @brief Get the number of vertices of the given coupling mesh.
+     *
+     * @param[in] meshIndex Index of the mesh as returned by setMesh.
+     * @return size_t Number of vertices of the mesh.
+     */
+    size_t getNumberOfVertices(const size_t meshIndex);
+    /*!
+     * @brief Get the number of coupling meshes.
+     *
+     * @return size_t Number of meshes set via setMesh.
+     */
+    size_t getNumberOfMeshes() const;
+    /*!
+     * @brief Get the simulation time at the end of the completed time windows.
+     *
+     * Iterations that are repeated because a checkpoint has to be read do
+     * not count. After readSnapshot, the time of the snapshot.
+     *
+     * @return double Simulation time.
+     */
+    double getTime() const { return time_; }
+    /*!
+     * @brief Get the timings and call counts of the coupling phases.
+     *
+     * @return const CouplingStatistics& Statistics recorded so far.
+     */
+    const CouplingStatistics &getStatistics() const { return statistics_; }
+    /*!
+     * @brief Get the memory held by the buffers and meshes of the adapter.
+     *
+     * @return MemoryUsage Memory per quantity and per mesh structure.
+     */
+    MemoryUsage getMemoryUsage() const;
+    /*!
+     * @brief Prints the memory held by the adapter to the given output stream.
+     *
+     * @param[in] os Output stream.
+     */
+    void printMemoryUsage(std::ostream &os) const;
+    /*!
+     * @brief Releases the data only needed to set up the coupling.
+     *
+     * The order in which the points were passed to setMesh is only needed
+     * to create the index mapping. It is released for all meshes with an
+     * index mapping, and unused capacity of the remaining containers is
+     * freed. Afterwards the index mapping of these meshes cannot be
+     * recreated. Must be called after initialize.
+     */
+    void releaseSetupData();
+    /*!
+     * @brief Requests a summary of the statistics at finalize.
+     *
+     * The summary and the memory usage are printed to std::cout.
+     * Additionally, the statistics of all phases and time windows are
+     * written as JSON, which allows to compare the participants of a
+     * coupled run.
+     *
+     * @param[in] jsonFileName File to write the JSON output to. No file is
+     *            written if the name is empty.
+     */
+    void enableStatisticsSummary(const std::string &jsonFileName = "");
+    /*!
+     * @brief Enables writing snapshots the run can be resumed from.
+     *
+     * A snapshot contains the buffers of all quantities, the index mapping
+     * of all meshes, the number of completed time windows and the state of
+     * the solver passed to writeSnapshot. The snapshot after time window n
+     * is written to the file with n appended to the file name, e.g.
+     * `snapshot.10`. The last two snapshots are kept. Every participant
+     * and, on distributed runs, every process needs its own file name.
+     *
+     * @param[in] fileName File name the snapshots are written to and read
+     *            from, without the time window.
+     * @param[in] interval Number of time windows between two snapshots.
+     */
+    void enableSnapshots(const std::string &fileName, const size_t interval);
+    /*!
+     * @brief Checks whether a snapshot is due after the last time window.
+     *
+     * Should be called once a time window is completed.
+     *
+     * @return true A snapshot is due.
+     * @return false No snapshot is due or snapshots are not enabled.
+     */
+    bool hasToWriteSnapshot() const;
+    /*!
+     * @brief Writes a snapshot of the coupling and of the solver.
+     *
+     * All data is copied and the file is written on a separate thread, so
+     * the coupling continues right away. The previous snapshot is replaced
+     * only after the new one was completely written. A snapshot still
+     * being written is waited for before the next one is started and at
+     * finalize.
+     *
+     * @param[in] solverState State of the solver, e.g. the flattened
+     *            solution vector, see flattenSolution.
+     */
+    void writeSnapshot(const std::vector<double> &solverState);
+    /*!
+     * @brief Reads the snapshot a previous run wrote after a time window.
+     *
+     * Must be called after all quantities have been announced and all
+     * index mappings have been created. The buffers of all quantities, the
+     * number of completed time windows and the time are restored. preCICE itself
+     * has no restart: the restarted run begins a new coupling at time zero,
+     * so the preCICE configuration has to cover the remaining time windows
+     * only and a quasi-Newton acceleration starts without history. Both
+     * participants have to pass the same time window. The data at the start
+     * of the time window is taken from the restored buffers, see
+     * enableTimeInterpolation, while the change of tracked quantities (see
+     * enableChangeTracking) is unknown until their second read.
+     *
+     * @param[out] solverState State of the solver passed to writeSnapshot.
+     * @param[in] timeWindow Number of completed time windows of the snapshot.
+     */
+    void readSnapshot(std::vector<double> &solverState,
+                      const size_t timeWindow);
+    /*!
+     * @brief Get the index of the mesh a quantity lives on.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     * @return size_t Index of the mesh as returned by setMesh.
+     */
+    size_t getMeshIndex(const size_t dataID) const;
     /*!
      * @brief Gets value of a scalar quantity.
      *
@@ -294,25 +884,51 @@ public:
      * @return double Value of scalar quantity.
      */
     double getScalarQuantityOnFace(const size_t dataID, const int faceID) const;
-    // /*!
-    //  * @brief Gets value of a vector quantity.
-    //  *
-    //  * @param[in] dataID Identifier of the quantity.
-    //  * @param[in] faceID Identifier of the face according to DuMuX' numbering.
-    //  * @return std::vector<double> Value of vector quantity.
-    //  */
-    // std::vector<double> getVectorQuantityOnFace(const size_t dataID, const int faceID) const;
-    // std::vector<double> getVectorQuantity(const size_t dataID) const;
     /*!
      * @brief Gets value of a vector quantity.
      *
+     * @tparam dim Number of spatial dimensions of the coupling.
      * @param[in] dataID Identifier of the quantity.
      * @param[in] faceID Identifier of the face according to DuMuX' numbering.
-     * @return const std::vector<double>& Value of vector quantity.
+     * @return Dune::FieldVector<double, dim> Value of vector quantity.
      */
-    const std::vector<double> &getVectorScalarQuantityOnFace(
+    template<int dim>
+    Dune::FieldVector<double, dim> getVectorQuantityOnFace(
         const size_t dataID,
         const int faceID) const;
+    /*!
+     * @brief Gets value of a scalar quantity interpolated in time.
+     *
+     * Requires enableTimeInterpolation. The value is interpolated linearly
+     * between the start and the end of the current time window.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     * @param[in] faceID Identifier of the face according to DuMuX' numbering.
+     * @param[in] relativeTime Time within the window divided by the window
+     *            size, 0 at the start and 1 at the end of the window.
+     * @return double Value of scalar quantity.
+     */
+    double getScalarQuantityOnFace(const size_t dataID,
+                                   const int faceID,
+                                   const double relativeTime) const;
+    /*!
+     * @brief Gets value of a vector quantity interpolated in time.
+     *
+     * Requires enableTimeInterpolation. The value is interpolated linearly
+     * between the start and the end of the current time window.
+     *
+     * @tparam dim Number of spatial dimensions of the coupling.
+     * @param[in] dataID Identifier of the quantity.
+     * @param[in] faceID Identifier of the face according to DuMuX' numbering.
+     * @param[in] relativeTime Time within the window divided by the window
+     *            size, 0 at the start and 1 at the end of the window.
+     * @return Dune::FieldVector<double, dim> Value of vector quantity.
+     */
+    template<int dim>
+    Dune::FieldVector<double, dim> getVectorQuantityOnFace(
+        const size_t dataID,
+        const int faceID,
+        const double relativeTime) const;
     /*!
      * @brief Writes value of scalar quantity on given face.
      *
@@ -323,10 +939,128 @@ public:
     void writeScalarQuantityOnFace(const size_t dataID,
                                    const int faceID,
                                    const double value);
+    /*!
+     * @brief Writes value of vector quantity on given face.
+     *
+     * @tparam dim Number of spatial dimensions of the coupling.
+     * @param[in] dataID Identifier of the quantity.
+     * @param[in] faceID Identifier of the face according to DuMuX' numbering.
+     * @param[in] value  Value of vector quantity.
+     */
+    template<int dim>
+    void writeVectorQuantityOnFace(const size_t dataID,
+                                   const int faceID,
+                                   const Dune::FieldVector<double, dim> &value);
+    /*!
+     * @brief Writes values of a vector quantity on a set of faces.
+     *
+     * @tparam dim Number of spatial dimensions of the coupling.
+     * @param[in] dataID Identifier of the quantity.
+     * @param[in] faceIDs Identifiers of the faces according to DuMuX' numbering.
+     * @param[in] values Values of the vector quantity on the faces.
+     */
+    template<int dim>
+    void writeVectorQuantityOnFaces(
+        const size_t dataID,
+        const std::vector<int> &faceIDs,
+        const std::vector<Dune::FieldVector<double, dim> > &values);
+    /*!
+     * @brief Reads values of a vector quantity on a set of faces.
+     *
+     * @tparam dim Number of spatial dimensions of the coupling.
+     * @param[in] dataID Identifier of the quantity.
+     * @param[in] faceIDs Identifiers of the faces according to DuMuX' numbering.
+     * @param[out] values Values of the vector quantity on the faces. The vector
+     *             is only reallocated if its size does not match.
+     */
+    template<int dim>
+    void readVectorQuantityOnFaces(
+        const size_t dataID,
+        const std::vector<int> &faceIDs,
+        std::vector<Dune::FieldVector<double, dim> > &values) const;
+
+    /*!
+     * @brief Writes values of a quantity on a set of faces.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     * @param[in] faceIDs Identifiers of the faces according to DuMuX' numbering.
+     * @param[in] values Values of the quantity on the faces. For vector quantities
+     *            the components of a face are stored consecutively.
+     */
+    void writeQuantityOnFaces(const size_t dataID,
+                              const std::vector<int> &faceIDs,
+                              const std::vector<double> &values);
+    /*!
+     * @brief Writes values of a quantity on all faces of the coupling interface.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     * @param[in] values Values of the quantity. The values must be ordered like
+     *            the face identifiers passed to createIndexMapping.
+     */
+    void writeQuantityOnFaces(const size_t dataID,
+                              const std::vector<double> &values);
+    /*!
+     * @brief Reads values of a quantity on a set of faces.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     * @param[in] faceIDs Identifiers of the faces according to DuMuX' numbering.
+     * @param[out] values Values of the quantity on the faces. For vector quantities
+     *             the components of a face are stored consecutively.
+     */
+    void readQuantityOnFaces(const size_t dataID,
+                             const std::vector<int> &faceIDs,
+                             std::vector<double> &values) const;
+    /*!
+     * @brief Reads values of a quantity on all faces of the coupling interface.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     * @param[out] values Values of the quantity, ordered like the face identifiers
+     *             passed to createIndexMapping.
+     */
+    void readQuantityOnFaces(const size_t dataID,
+                             std::vector<double> &values) const;
+
+    /*!
+     * @brief Binds a user-provided buffer to a quantity.
+     *
+     * preCICE reads and writes the quantity directly from and to the given
+     * memory, the adapter does not hold a copy of the data anymore. The
+     * buffer has to stay valid until it is unbound or the coupling is
+     * finalized. The values are stored in the same order as in the adapter's
+     * own buffer, i.e., ordered by preCICE's vertex identifiers and, for vector
+     * quantities, with the components of each vertex stored consecutively.
+     * Contiguous storage like `std::vector<double>::data()` or `&v[0][0]` of a
+     * `Dune::BlockVector<Dune::FieldVector<double, dim>>` can be used.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     * @param[in] buffer Pointer to the first value of the buffer.
+     * @param[in] size Number of values in the buffer.
+     */
+    void bindQuantityBuffer(const size_t dataID,
+                            double *buffer,
+                            const size_t size);
+    /*!
+     * @brief Unbinds a user-provided buffer from a quantity.
+     *
+     * The current values are copied back into the adapter's own buffer.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     */
+    void unbindQuantityBuffer(const size_t dataID);
+    /*!
+     * @brief Checks whether a user-provided buffer is bound to a quantity.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     * @return true A user-provided buffer is bound.
+     * @return false The adapter's own buffer is used.
+     */
+    bool hasExternalBuffer(const size_t dataID) const;
 
     /*!
      * @brief Returns reference to data vector of quantity with given identifier.
      *
+     * \note Must not be called if a user-provided buffer was bound to the quantity.
+     *
      * @param dataID Identifier of the quantity.
      * @return[in] std::vector<double>& Reference to data vector.
      */
@@ -345,7 +1079,8 @@ public:
      * @param[in] dataID Identifier of the quantity.
      * @param[in] values Value of the scalar or vector quantity.
      */
-    void writeQuantityVector(const size_t dataID, std::vector<double> &values);
+    void writeQuantityVector(const size_t dataID,
+                             const std::vector<double> &values);
     /*!
      * @brief Writes data from adapter's buffer into preCICE's communication buffer.
      *
@@ -373,25 +1108,250 @@ public:
      */
     void readScalarQuantityFromOtherSolver(const size_t dataID);
     /*!
-     * @brief Writes data from adapter's buffer into preCICE's communication buffer.
+     * @brief Writes data of a vector quantity from adapter's buffer into preCICE's communication buffer.
      *
      * @param[in] dataID Identifier of the quantity to write into communication buffer.
      */
+    void writeVectorQuantityToOtherSolver(const size_t dataID);
+    /*!
+     * @brief Reads data of a vector quantity from preCICE's communication buffer and puts it into adapter's buffer.
+     *
+     * @param dataID Identifier of the quantity to read into adapter buffer.
+     */
+    void readVectorQuantityFromOtherSolver(const size_t dataID);
+    /*!
+     * @brief Writes data of a scalar quantity from adapter's buffer into preCICE's communication buffer.
+     *
+     * @param[in] quantity Handle of the quantity.
+     */
+    void writeQuantityToOtherSolver(const ScalarQuantityHandle quantity);
+    /*!
+     * @brief Writes data of a vector quantity from adapter's buffer into preCICE's communication buffer.
+     *
+     * @param[in] quantity Handle of the quantity.
+     */
+    void writeQuantityToOtherSolver(const VectorQuantityHandle quantity);
+    /*!
+     * @brief Reads data of a scalar quantity from preCICE's communication buffer and puts it into adapter's buffer.
+     *
+     * @param[in] quantity Handle of the quantity.
+     */
+    void readQuantityFromOtherSolver(const ScalarQuantityHandle quantity);
+    /*!
+     * @brief Reads data of a vector quantity from preCICE's communication buffer and puts it into adapter's buffer.
+     *
+     * @param[in] quantity Handle of the quantity.
+     */
+    void readQuantityFromOtherSolver(const VectorQuantityHandle quantity);
+    /*!
+     * @brief Writes several quantities from the adapter's buffers into preCICE's communication buffers.
+     *
+     * The quantities are transferred in one pass, grouped by mesh such
+     * that the vertex identifiers of a mesh are traversed consecutively.
+     *
+     * @param[in] dataIDs Identifiers or handles of the quantities, e.g. `{pressureId, concentrationId}`.
+     */
+    void writeQuantitiesToOtherSolver(const std::vector<size_t> &dataIDs);
+    /*!
+     * @brief Reads several quantities from preCICE's communication buffers into the adapter's buffers.
+     *
+     * The quantities are transferred in one pass, grouped by mesh such
+     * that the vertex identifiers of a mesh are traversed consecutively.
+     *
+     * @param[in] dataIDs Identifiers or handles of the quantities, e.g. `{velocityId, temperatureId}`.
+     */
+    void readQuantitiesFromOtherSolver(const std::vector<size_t> &dataIDs);
+    // Passing a handle of the wrong kind is an error
+    void writeScalarQuantityToOtherSolver(const VectorQuantityHandle) = delete;
+    void readScalarQuantityFromOtherSolver(const VectorQuantityHandle) = delete;
+    void writeVectorQuantityToOtherSolver(const ScalarQuantityHandle) = delete;
+    void readVectorQuantityFromOtherSolver(const ScalarQuantityHandle) = delete;
+    /*!
+     * @brief Enables computing the change of a quantity between two reads.
+     *
+     * The change is computed by a second loop over the data right after
+     * the read from preCICE, while the data is still in the cache. For
+     * this, the adapter keeps a second buffer holding the data of the
+     * previous read. The change is only computed between reads of the
+     * same time window, i.e. between coupling iterations.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     */
+    void enableChangeTracking(const size_t dataID);
+    /*!
+     * @brief Get the Euclidean norm of the change of a quantity in the last read.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     * @return double Norm of the difference between the data of the last
+     *         and the previous read. Infinity if the quantity has been read
+     *         less than twice in the current time window.
+     */
+    double getQuantityChangeNorm(const size_t dataID) const;
+    /*!
+     * @brief Get the relative change of a quantity in the last read.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     * @return double Norm of the change divided by the norm of the data of
+     *         the last read. The absolute change is returned if the data
+     *         is zero.
+     */
+    double getRelativeQuantityChange(const size_t dataID) const;
+    /*!
+     * @brief Get the relative change of a quantity since the given data.
+     *
+     * Does not require change tracking.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     * @param[in] reference Earlier data of the quantity, e.g. the data the
+     *            solution was last computed for.
+     * @return double Norm of the difference between the current data and
+     *         the reference divided by the norm of the current data. The
+     *         absolute change is returned if the data is zero. Infinity if
+     *         the reference does not match the size of the quantity.
+     */
+    double getRelativeQuantityChange(
+        const size_t dataID,
+        const std::vector<double> &reference) const;
+    /*!
+     * @brief Get the interface residual of the last read.
+     *
+     * The residual is the largest relative change of all quantities whose
+     * change is tracked, see enableChangeTracking. Within a time window, it
+     * is the residual of the fixed-point iteration between the solvers.
+     *
+     * @return double The interface residual. Infinity if no tracked
+     *         quantity has been read twice in the current time window,
+     *         i.e. in the first coupling iteration of every time window.
+     */
+    double getInterfaceResidual() const;
+    /*!
+     * @brief Get the interface residuals of the coupling iterations of the
+     *        current time window.
+     *
+     * @return const std::vector<double>& Residual of every coupling
+     *         iteration completed by advance in the current time window.
+     *         Substeps of a subcycled time window are not iterations.
+     */
+    const std::vector<double> &getWindowResiduals() const
+    {
+        return windowResiduals_;
+    }
+    /*!
+     * @brief Get the convergence rate of the coupling iterations.
+     *
+     * @return double Ratio of the residuals of the last two coupling
+     *         iterations of the current time window. NaN if less than two
+     *         iterations have been completed.
+     */
+    double getConvergenceRate() const;
+    /*!
+     * @brief Get the tolerance of the inner solver for inexact coupling
+     *        iterations.
+     *
+     * Early coupling iterations of a time window only need to be solved
+     * loosely, since the interface data they are based on is replaced in
+     * the next iteration anyway. The returned tolerance is proportional to
+     * the interface residual of the last read and is tightened as the
+     * coupling converges. In the first coupling iteration of a time window,
+     * the residual is unknown and maxTolerance is returned. Should be called
+     * after the read and before the solve, e.g. to set the maximum relative
+     * shift of the Newton solver.
+     *
+     * @param[in] tolerance Tolerance of a converged interface.
+     * @param[in] maxTolerance Tolerance if the residual is large or unknown.
+     * @param[in] factor Ratio of the tolerance and the interface residual.
+     * @return double Tolerance between tolerance and maxTolerance.
+     */
+    double getInexactSolverTolerance(const double tolerance,
+                                     const double maxTolerance,
+                                     const double factor) const;
+    /*!
+     * @brief Enables logging the interface residuals.
+     *
+     * For every coupling iteration, the time window, the iteration, the
+     * interface residual and the convergence rate are written as one line.
+     * The file is flushed once a time window is completed.
+     *
+     * @param[in] fileName File to write the log to.
+     */
+    void enableResidualLog(const std::string &fileName);
+    /*!
+     * @brief Enables interpolating a quantity in time within a time window.
+     *
+     * Meant for subcycling, i.e. taking several time steps per time window.
+     * The adapter keeps a second buffer with the data at the start of the
+     * current time window, which is the data of the last read in the
+     * previous window. The data read in the current window holds the values
+     * at its end. In the first window the data is constant in time. The
+     * buffer of the quantity must not be modified between reads.
+     *
+     * @param[in] dataID Identifier of the quantity.
+     */
+    void enableTimeInterpolation(const size_t dataID);
     /*!
      * @brief Checks whether face with given identifier is part of coupling interface.
      *
+     * Refers to the first mesh, see the overload taking a mesh index.
+     *
      * @param[in] faceID Identifier of the face according to DuMuX' numbering.
      * @return true Face is part of coupling interface.
      * @return false Face is not part of coupling interface.
      */
     bool isCoupledEntity(const int faceID) const;
+    /*!
+     * @brief Checks whether face with given identifier is part of the given coupling mesh.
+     *
+     * @param[in] meshIndex Index of the mesh as returned by setMesh.
+     * @param[in] faceID Identifier of the face according to DuMuX' numbering.
+     * @return true Face is part of the mesh.
+     * @return false Face is not part of the mesh.
+     */
+    bool isCoupledEntity(const size_t meshIndex, const int faceID) const;
     /*!
      * @brief Get a quantity's numeric identifier from its name.
      *
+     * If quantities of the name live on several meshes, the one on the mesh
+     * with the lowest index is returned.
+     *
      * @param[in] dataName Name of the quantity.
      * @return size_t Numeric identifier of quantity.
      */
     size_t getIdFromName(const std::string &dataName) const;
+    /*!
+     * @brief Get the numeric identifier of a quantity on the given mesh from its name.
+     *
+     * @param[in] meshIndex Index of the mesh as returned by setMesh.
+     * @param[in] dataName Name of the quantity.
+     * @return size_t Numeric identifier of quantity.
+     */
+    size_t getIdFromName(const size_t meshIndex,
+                         const std::string &dataName) const;
+    /*!
+     * @brief Get the typed handle of a quantity from its name.
+     *
+     * @tparam Type Expected type (Scalar or Vector) of the quantity.
+     * @param[in] dataName Name of the quantity.
+     * @return QuantityHandle<Type> Handle of the quantity.
+     */
+    template<QuantityType Type>
+    QuantityHandle<Type> getHandleFromName(const std::string &dataName) const
+    {
+        return makeHandle_<Type>(getIdFromName(dataName));
+    }
+    /*!
+     * @brief Get the typed handle of a quantity on the given mesh from its name.
+     *
+     * @tparam Type Expected type (Scalar or Vector) of the quantity.
+     * @param[in] meshIndex Index of the mesh as returned by setMesh.
+     * @param[in] dataName Name of the quantity.
+     * @return QuantityHandle<Type> Handle of the quantity.
+     */
+    template<QuantityType Type>
+    QuantityHandle<Type> getHandleFromName(const size_t meshIndex,
+                                           const std::string &dataName) const
+    {
+        return makeHandle_<Type>(getIdFromName(meshIndex, dataName));
+    }
     /*!
      * @brief Get a quantitiy's name from its numeric identifier.
      *
@@ -407,5 +1367,108 @@ public:
     void print(std::ostream &os);
 };
 
+template<int dim>
+Dune::FieldVector<double, dim> CouplingAdapter::getVectorQuantityOnFace(
+    const size_t dataID,
+    const int faceID) const
+{
+    assert(wasCreated_);
+    assert(dataID < quantityTypes_.size());
+    assert(meshes_[quantityMeshes_[dataID]].hasIndexMapper);
+    assert(quantityTypes_[dataID] == QuantityType::Vector);
+    assert(dim == getDimensions());
+    const size_t idx = getBufferIndex_(dataID, faceID) * dim;
+    assert(idx + dim <= getQuantitySize_(dataID));
+    const double *data = getQuantityData_(dataID) + idx;
+
+    Dune::FieldVector<double, dim> value;
+    for (int d = 0; d < dim; ++d)
+        value[d] = data[d];
+    return value;
+}
+
+template<int dim>
+Dune::FieldVector<double, dim> CouplingAdapter::getVectorQuantityOnFace(
+    const size_t dataID,
+    const int faceID,
+    const double relativeTime) const
+{
+    assert(wasCreated_);
+    assert(dataID < quantityTypes_.size());
+    assert(meshes_[quantityMeshes_[dataID]].hasIndexMapper);
+    assert(quantityTypes_[dataID] == QuantityType::Vector);
+    assert(dim == getDimensions());
+    assert(interpolatesInTime_[dataID]);
+    assert(relativeTime >= 0. && relativeTime <= 1.);
+    const size_t idx = getBufferIndex_(dataID, faceID) * dim;
+    assert(idx + dim <= getQuantitySize_(dataID));
+    const double *end = getQuantityData_(dataID) + idx;
+    const double *start = windowStartDataVectors_[dataID].data() + idx;
+
+    Dune::FieldVector<double, dim> value;
+    for (int d = 0; d < dim; ++d)
+        value[d] = (1. - relativeTime) * start[d] + relativeTime * end[d];
+    return value;
+}
+
+template<int dim>
+void CouplingAdapter::writeVectorQuantityOnFace(
+    const size_t dataID,
+    const int faceID,
+    const Dune::FieldVector<double, dim> &value)
+{
+    assert(wasCreated_);
+    assert(dataID < quantityTypes_.size());
+    assert(meshes_[quantityMeshes_[dataID]].hasIndexMapper);
+    assert(quantityTypes_[dataID] == QuantityType::Vector);
+    assert(dim == getDimensions());
+    const size_t idx = getBufferIndex_(dataID, faceID) * dim;
+    assert(idx + dim <= getQuantitySize_(dataID));
+    double *data = getQuantityData_(dataID) + idx;
+
+    for (int d = 0; d < dim; ++d)
+        data[d] = value[d];
+}
+
+template<int dim>
+void CouplingAdapter::writeVectorQuantityOnFaces(
+    const size_t dataID,
+    const std::vector<int> &faceIDs,
+    const std::vector<Dune::FieldVector<double, dim> > &values)
+{
+    assert(wasCreated_);
+    assert(dataID < quantityTypes_.size());
+    assert(quantityTypes_[dataID] == QuantityType::Vector);
+    assert(dim == getDimensions());
+    assert(values.size() == faceIDs.size());
+
+    double *data = getQuantityData_(dataID);
+    for (size_t i = 0; i < faceIDs.size(); ++i) {
+        double *faceData = data + getBufferIndex_(dataID, faceIDs[i]) * dim;
+        for (int d = 0; d < dim; ++d)
+            faceData[d] = values[i][d];
+    }
+}
+
+template<int dim>
+void CouplingAdapter::readVectorQuantityOnFaces(
+    const size_t dataID,
+    const std::vector<int> &faceIDs,
+    std::vector<Dune::FieldVector<double, dim> > &values) const
+{
+    assert(wasCreated_);
+    assert(dataID < quantityTypes_.size());
+    assert(quantityTypes_[dataID] == QuantityType::Vector);
+    assert(dim == getDimensions());
+
+    values.resize(faceIDs.size());
+    const double *data = getQuantityData_(dataID);
+    for (size_t i = 0; i < faceIDs.size(); ++i) {
+        const double *faceData = data + getBufferIndex_(dataID, faceIDs[i]) * dim;
+        for (int d = 0; d < dim; ++d)
+            values[i][d] = faceData[d];
+    }
+}
+
 }  // namespace Dumux::Precice
 #endif
@@ -0,0 +1,133 @@
+#include "couplingstatistics.hh"
+
+#include <iomanip>
+
+using namespace Dumux::Precice;
+
+void CouplingStatistics::addMeasurement(const CouplingPhase phase,
+                                        const Clock::time_point start)
+{
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+    addMeasurement(phase, elapsed.count());
+}
+
+void CouplingStatistics::addMeasurement(const CouplingPhase phase,
+                                        const double seconds)
+{
+    const auto idx = static_cast<std::size_t>(phase);
+    phases_[idx].time += seconds;
+    ++phases_[idx].calls;
+    currentWindow_.phases[idx].time += seconds;
+    ++currentWindow_.phases[idx].calls;
+    if (solverPhaseActive_ && phase != CouplingPhase::Solver)
+        timeInOtherPhases_ += seconds;
+}
+
+void CouplingStatistics::startSolverPhase()
+{
+    solverPhaseActive_ = true;
+    solverPhaseStart_ = Clock::now();
+    timeInOtherPhases_ = 0.;
+}
+
+void CouplingStatistics::finishSolverPhase()
+{
+    if (!solverPhaseActive_)
+        return;
+    solverPhaseActive_ = false;
+    const std::chrono::duration<double> elapsed =
+        Clock::now() - solverPhaseStart_;
+    addMeasurement(CouplingPhase::Solver, elapsed.count() - timeInOtherPhases_);
+}
+
+void CouplingStatistics::completeIteration(const bool timeWindowComplete)
+{
+    ++iterations_;
+    ++currentWindow_.iterations;
+    if (timeWindowComplete) {
+        timeWindows_.push_back(currentWindow_);
+        currentWindow_ = TimeWindowStatistics();
+    }
+}
+
+const char *CouplingStatistics::phaseName(const CouplingPhase phase)
+{
+    switch (phase) {
+        case CouplingPhase::Initialize:
+            return "initialize";
+        case CouplingPhase::InitializeData:
+            return "initializeData";
+        case CouplingPhase::Advance:
+            return "advance";
+        case CouplingPhase::ReadBlockData:
+            return "readBlockData";
+        case CouplingPhase::WriteBlockData:
+            return "writeBlockData";
+        case CouplingPhase::WriteCheckpoint:
+            return "writeCheckpoint";
+        case CouplingPhase::ReadCheckpoint:
+            return "readCheckpoint";
+        case CouplingPhase::Solver:
+            return "solver";
+    }
+    return "unknown";
+}
+
+void CouplingStatistics::printSummary(std::ostream &os) const
+{
+    double total = 0.;
+    for (const auto &p : phases_)
+        total += p.time;
+
+    os << "Coupling statistics\n";
+    os << "  time windows: " << timeWindows_.size()
+       << ", coupling iterations: " << iterations_ << "\n";
+    if (!timeWindows_.empty())
+        os << "  average iterations per time window: "
+           << double(iterations_) / timeWindows_.size() << "\n";
+    for (std::size_t i = 0; i < numberOfPhases; ++i) {
+        const auto &p = phases_[i];
+        os << "  " << std::left << std::setw(16)
+           << phaseName(static_cast<CouplingPhase>(i)) << std::right
+           << std::setw(12) << p.time << " s" << std::setw(10) << p.calls
+           << " calls";
+        if (total > 0.)
+            os << std::setw(8) << std::fixed << std::setprecision(1)
+               << 100. * p.time / total << " %" << std::defaultfloat
+               << std::setprecision(6);
+        os << "\n";
+    }
+}
+
+void CouplingStatistics::writeJson(std::ostream &os) const
+{
+    const auto writePhases =
+        [&os](const std::array<PhaseStatistics, numberOfPhases> &phases) {
+            os << "{";
+            for (std::size_t i = 0; i < numberOfPhases; ++i) {
+                os << (i == 0 ? "" : ", ") << "\""
+                   << phaseName(static_cast<CouplingPhase>(i))
+                   << "\": {\"time\": " << phases[i].time
+                   << ", \"calls\": " << phases[i].calls << "}";
+            }
+            os << "}";
+        };
+
+    const auto prec = os.precision();
+    os << std::setprecision(9);
+    os << "{\n";
+    os << "  \"iterations\": " << iterations_ << ",\n";
+    os << "  \"phases\": ";
+    writePhases(phases_);
+    os << ",\n";
+    os << "  \"timeWindows\": [";
+    for (std::size_t w = 0; w < timeWindows_.size(); ++w) {
+        os << (w == 0 ? "\n" : ",\n") << "    {\"iterations\": "
+           << timeWindows_[w].iterations << ", \"phases\": ";
+        writePhases(timeWindows_[w].phases);
+        os << "}";
+    }
+    os << (timeWindows_.empty() ? "]\n" : "\n  ]\n");
+    os << "}\n";
+    os.precision(prec);
+}
@@ -0,0 +1,189 @@
+#ifndef DUMUXPRECICE_COUPLINGSTATISTICS_HH
+#define DUMUXPRECICE_COUPLINGSTATISTICS_HH
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace Dumux::Precice
+{
+/*!
+ * @brief Phases of a coupled simulation timed by the coupling adapter.
+ *
+ * - `Initialize`: precice::SolverInterface::initialize.
+ * - `InitializeData`: precice::SolverInterface::initializeData.
+ * - `Advance`: precice::SolverInterface::advance, i.e. communication,
+ *   waiting for the other participant, mapping and acceleration.
+ * - `ReadBlockData`/`WriteBlockData`: Block reads and writes from and to
+ *   preCICE's buffers.
+ * - `WriteCheckpoint`/`ReadCheckpoint`: Time between the adapter reporting
+ *   that a checkpoint has to be written/read and the solver announcing
+ *   that it has done so.
+ * - `Solver`: Remaining wall time between two calls to advance (or
+ *   initializeData and the first advance), i.e. the time spent by the
+ *   solver itself.
+ */
+enum class CouplingPhase {
+    Initialize,
+    InitializeData,
+    Advance,
+    ReadBlockData,
+    WriteBlockData,
+    WriteCheckpoint,
+    ReadCheckpoint,
+    Solver
+};
+
+/*!
+ * @brief Cumulative and per time window timings and call counts of the
+ *        phases of a coupled simulation.
+ *
+ */
+class CouplingStatistics
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    //! Number of phases in CouplingPhase.
+    static constexpr std::size_t numberOfPhases = 8;
+
+    /*!
+     * @brief Wall time and number of calls of one phase.
+     *
+     */
+    struct PhaseStatistics {
+        //! Accumulated wall time in seconds.
+        double time = 0.;
+        //! Number of measurements.
+        std::size_t calls = 0;
+    };
+
+    /*!
+     * @brief Statistics of one completed time window.
+     *
+     */
+    struct TimeWindowStatistics {
+        //! Number of coupling iterations, i.e. calls to advance, in the window.
+        std::size_t iterations = 0;
+        //! Statistics of all phases within the window.
+        std::array<PhaseStatistics, numberOfPhases> phases;
+    };
+
+    /*!
+     * @brief Measures the wall time of a scope and adds it to a phase.
+     *
+     */
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(CouplingStatistics &statistics, const CouplingPhase phase)
+            : statistics_(statistics), phase_(phase), start_(Clock::now())
+        {
+        }
+        ~ScopedTimer() { statistics_.addMeasurement(phase_, start_); }
+        ScopedTimer(const ScopedTimer &) = delete;
+        void operator=(const ScopedTimer &) = delete;
+
+    private:
+        CouplingStatistics &statistics_;
+        const CouplingPhase phase_;
+        const Clock::time_point start_;
+    };
+
+    /*!
+     * @brief Adds the time elapsed since start to the given phase.
+     *
+     * @param[in] phase Phase the measurement belongs to.
+     * @param[in] start Start of the measurement.
+     */
+    void addMeasurement(const CouplingPhase phase,
+                        const Clock::time_point start);
+    /*!
+     * @brief Adds a measurement to the given phase.
+     *
+     * @param[in] phase Phase the measurement belongs to.
+     * @param[in] seconds Measured wall time in seconds.
+     */
+    void addMeasurement(const CouplingPhase phase, const double seconds);
+    /*!
+     * @brief Marks the end of the solver's work between two calls to advance.
+     *
+     * The time since the last call to finishSolverPhase or startSolverPhase
+     * that was not spent in block reads/writes or checkpointing is added
+     * to the `Solver` phase.
+     */
+    void finishSolverPhase();
+    //! Marks the beginning of the solver's work between two calls to advance.
+    void startSolverPhase();
+    /*!
+     * @brief Records that a coupling iteration has been completed.
+     *
+     * @param[in] timeWindowComplete True if the iteration completed the time window.
+     */
+    void completeIteration(const bool timeWindowComplete);
+    /*!
+     * @brief Gets the cumulative statistics of a phase.
+     *
+     * @param[in] phase The phase.
+     * @return const PhaseStatistics& Statistics of the phase.
+     */
+    const PhaseStatistics &phase(const CouplingPhase phase) const
+    {
+        return phases_[static_cast<std::size_t>(phase)];
+    }
+    /*!
+     * @brief Gets the statistics of all completed time windows.
+     *
+     * @return const std::vector<TimeWindowStatistics>& Statistics per time window.
+     */
+    const std::vector<TimeWindowStatistics> &timeWindows() const
+    {
+        return timeWindows_;
+    }
+    /*!
+     * @brief Gets the total number of coupling iterations.
+     *
+     * @return std::size_t Number of calls to advance.
+     */
+    std::size_t numberOfIterations() const { return iterations_; }
+    /*!
+     * @brief Prints a human-readable summary to the given output stream.
+     *
+     * @param os Output stream.
+     */
+    void printSummary(std::ostream &os) const;
+    /*!
+     * @brief Writes all statistics as JSON to the given output stream.
+     *
+     * @param os Output stream.
+     */
+    void writeJson(std::ostream &os) const;
+    /*!
+     * @brief Gets the name of a phase.
+     *
+     * @param[in] phase The phase.
+     * @return const char* Name of the phase.
+     */
+    static const char *phaseName(const CouplingPhase phase);
+
+private:
+    //! Cumulative statistics of all phases.
+    std::array<PhaseStatistics, numberOfPhases> phases_;
+    //! Statistics of the current, not yet completed, time window.
+    TimeWindowStatistics currentWindow_;
+    //! Statistics of all completed time windows.
+    std::vector<TimeWindowStatistics> timeWindows_;
+    //! Total number of coupling iterations.
+    std::size_t iterations_ = 0;
+    //! True if the solver is currently working between two calls to advance.
+    bool solverPhaseActive_ = false;
+    //! Start of the current solver phase.
+    Clock::time_point solverPhaseStart_;
+    //! Time spent in other measured phases since solverPhaseStart_.
+    double timeInOtherPhases_ = 0.;
+};
+
+}  // namespace Dumux::Precice
+
+#endif  // DUMUXPRECICE_COUPLINGSTATISTICS_HH
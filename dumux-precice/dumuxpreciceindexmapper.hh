@@ -1,12 +1,31 @@
 #ifndef DUMUXPRECICEINDEXWRAPPER_H
 #define DUMUXPRECICEINDEXWRAPPER_H
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
-#include <map>
+#include <limits>
 #include <ostream>
+#include <utility>
 #include <vector>
 
+namespace Dumux::Precice
+{
+/*!
+ * @brief Storage layout used for the mapping from DuMuX' face indices
+ *        to preCICE's vertex indices.
+ *
+ * - `Dense`: Lookup table indexed by the DuMuX face index. Lookups are O(1),
+ *   but the table has as many entries as the largest coupled face index.
+ *   This is the right choice if the coupled faces are a reasonable fraction
+ *   of all faces, which is the case for typical DuMuX grids.
+ * - `Sparse`: Sorted vector of index pairs. Lookups are O(log n) binary
+ *   searches on contiguous memory. The memory consumption only depends on
+ *   the number of coupled faces.
+ */
+enum class IndexMappingType { Dense, Sparse };
+}  // namespace Dumux::Precice
+
 /*!
  * @brief Namespace of dumux-precice internals
  *
@@ -19,16 +38,58 @@ namespace Dumux::Precice::Internal
 /*!
  * @brief Mapping between preCICE vertex indices and DuMuX face indices.
  *
+ * The mapping is stored in flat, contiguous tables. The mapping from
+ * preCICE's vertex indices to DuMuX' face indices is always a dense table
+ * since preCICE numbers the vertices of a mesh consecutively. The layout
+ * of the mapping from DuMuX' face indices to preCICE's vertex indices
+ * can be selected via IndexMappingType.
+ *
  * @tparam T Data type of the indices.
  */
 template<typename T>
 class DumuxPreciceIndexMapper
 {
 private:
-    //!  Mapping from Dumux' face indices to preCICE's vertex indices.
-    std::map<T, T> dumuxFaceIndexToPreciceIndex_;
-    //!  Mapping from preCICE's vertex indices to Dumux' face indices.
-    std::map<T, T> preciceVertexToDumuxFaceIndex_;
+    //! Marker for table entries not belonging to the coupling interface.
+    static constexpr T invalidIndex_ = std::numeric_limits<T>::max();
+    //! Layout of the mapping from DuMuX' face indices to preCICE's vertex indices.
+    IndexMappingType mappingType_ = IndexMappingType::Dense;
+    //! Number of face/vertex indices mapped.
+    size_t size_ = 0;
+    //!  Dense mapping from Dumux' face indices to preCICE's vertex indices.
+    std::vector<T> dumuxFaceIndexToPreciceIndex_;
+    //!  Sorted pairs of Dumux' face indices and preCICE's vertex indices.
+    std::vector<std::pair<T, T> > sortedDumuxFaceIndexToPreciceIndex_;
+    //!  Dense mapping from preCICE's vertex indices to Dumux' face indices.
+    std::vector<T> preciceVertexToDumuxFaceIndex_;
+
+    /*!
+     * @brief Gets preCICE's vertex index or invalidIndex_ if the DuMuX
+     *        face index is not mapped.
+     *
+     * @param[in] dumuxId DuMuX face index.
+     * @return T preCICE vertex index.
+     */
+    T findPreciceId_(const T dumuxId) const
+    {
+        if (mappingType_ == IndexMappingType::Dense) {
+            if (dumuxId < 0 ||
+                static_cast<size_t>(dumuxId) >=
+                    dumuxFaceIndexToPreciceIndex_.size())
+                return invalidIndex_;
+            return dumuxFaceIndexToPreciceIndex_[dumuxId];
+        }
+        const auto it = std::lower_bound(
+            sortedDumuxFaceIndexToPreciceIndex_.begin(),
+            sortedDumuxFaceIndexToPreciceIndex_.end(), dumuxId,
+            [](const std::pair<T, T> &entry, const T id) {
+                return entry.first < id;
+            });
+        if (it == sortedDumuxFaceIndexToPreciceIndex_.end() ||
+            it->first != dumuxId)
+            return invalidIndex_;
+        return it->second;
+    }
 
 public:
     /*!
@@ -42,18 +103,49 @@ public:
      *
      * @param[in] dumuxIndices Vector of DuMuX' face indices.
      * @param[in] preciceIndices Vector of preCICE's vertex indices.
+     * @param[in] mappingType Layout of the DuMuX to preCICE mapping.
      */
     void createMapping(const std::vector<T> &dumuxIndices,
-                       const std::vector<T> &preciceIndices)
+                       const std::vector<T> &preciceIndices,
+                       const IndexMappingType mappingType =
+                           IndexMappingType::Dense)
     {
         assert(dumuxIndices.size() == preciceIndices.size());
-        const size_t size_ = dumuxIndices.size();
+        mappingType_ = mappingType;
+        size_ = dumuxIndices.size();
+
+        dumuxFaceIndexToPreciceIndex_.clear();
+        sortedDumuxFaceIndexToPreciceIndex_.clear();
+        preciceVertexToDumuxFaceIndex_.clear();
+        if (size_ == 0)
+            return;
 
-        for (T i = 0; i < size_; i++) {
-            preciceVertexToDumuxFaceIndex_.emplace(preciceIndices[i],
-                                                   dumuxIndices[i]);
-            dumuxFaceIndexToPreciceIndex_.emplace(dumuxIndices[i],
-                                                  preciceIndices[i]);
+        const T maxPreciceId =
+            *std::max_element(preciceIndices.begin(), preciceIndices.end());
+        assert(maxPreciceId >= 0);
+        preciceVertexToDumuxFaceIndex_.assign(size_t(maxPreciceId) + 1,
+                                              invalidIndex_);
+        for (size_t i = 0; i < size_; i++)
+            preciceVertexToDumuxFaceIndex_[preciceIndices[i]] =
+                dumuxIndices[i];
+
+        if (mappingType_ == IndexMappingType::Dense) {
+            const T maxDumuxId =
+                *std::max_element(dumuxIndices.begin(), dumuxIndices.end());
+            assert(*std::min_element(dumuxIndices.begin(),
+                                     dumuxIndices.end()) >= 0);
+            dumuxFaceIndexToPreciceIndex_.assign(size_t(maxDumuxId) + 1,
+                                                 invalidIndex_);
+            for (size_t i = 0; i < size_; i++)
+                dumuxFaceIndexToPreciceIndex_[dumuxIndices[i]] =
+                    preciceIndices[i];
+        } else {
+            sortedDumuxFaceIndexToPreciceIndex_.reserve(size_);
+            for (size_t i = 0; i < size_; i++)
+                sortedDumuxFaceIndexToPreciceIndex_.emplace_back(
+                    dumuxIndices[i], preciceIndices[i]);
+            std::sort(sortedDumuxFaceIndexToPreciceIndex_.begin(),
+                      sortedDumuxFaceIndexToPreciceIndex_.end());
         }
     }
     /*!
@@ -65,7 +157,7 @@ public:
     const T getPreciceId(const T dumuxId) const
     {
         assert(isDumuxIdMapped(dumuxId));
-        return dumuxFaceIndexToPreciceIndex_.at(dumuxId);
+        return findPreciceId_(dumuxId);
     }
     /*!
      * @brief Gets DuMuX' face index basde on a preCICE vertex index.
@@ -76,7 +168,7 @@ public:
     const T getDumuxId(const T preciceId) const
     {
         assert(isPreciceIdMapped(preciceId));
-        return preciceVertexToDumuxFaceIndex_.at(preciceId);
+        return preciceVertexToDumuxFaceIndex_[preciceId];
     }
     /*!
      * @brief Checks if a DuMuX face index is mapped to a preCICE vertex index.
@@ -87,7 +179,7 @@ public:
      */
     bool isDumuxIdMapped(const T dumuxId) const
     {
-        return dumuxFaceIndexToPreciceIndex_.count(dumuxId) == 1;
+        return findPreciceId_(dumuxId) != invalidIndex_;
     }
     /*!
      * @brief Checkes if a preCICE vertex index is mapped to a DuMuX face index.
@@ -98,14 +190,35 @@ public:
      */
     bool isPreciceIdMapped(const T preciceId) const
     {
-        return preciceVertexToDumuxFaceIndex_.count(preciceId) == 1;
+        return preciceId >= 0 &&
+               static_cast<size_t>(preciceId) <
+                   preciceVertexToDumuxFaceIndex_.size() &&
+               preciceVertexToDumuxFaceIndex_[preciceId] != invalidIndex_;
     }
     /*!
      * @brief Gets the size of the mapping table
      *
      * @return size_t Number of face/vertex indices mapped.
      */
-    size_t getSize() const { return preciceVertexToDumuxFaceIndex_.size(); }
+    size_t getSize() const { return size_; }
+    /*!
+     * @brief Gets the layout of the DuMuX to preCICE mapping.
+     *
+     * @return IndexMappingType Layout of the mapping.
+     */
+    IndexMappingType getMappingType() const { return mappingType_; }
+    /*!
+     * @brief Gets the memory held by the mapping tables.
+     *
+     * @return size_t Number of bytes allocated by the tables.
+     */
+    size_t getMemoryUsage() const
+    {
+        return dumuxFaceIndexToPreciceIndex_.capacity() * sizeof(T) +
+               sortedDumuxFaceIndexToPreciceIndex_.capacity() *
+                   sizeof(std::pair<T, T>) +
+               preciceVertexToDumuxFaceIndex_.capacity() * sizeof(T);
+    }
     /*!
      * @brief Destructor
      *
@@ -131,15 +244,25 @@ std::ostream &operator<<(std::ostream &os,
 {
     os << "preCICE to DuMuX mapping "
        << "\n";
-    for (const auto &v : wrapper.preciceVertexToDumuxFaceIndex_) {
-        os << v.first << " -> " << wrapper.getDumuxId(v.first) << "\n";
+    for (size_t i = 0; i < wrapper.preciceVertexToDumuxFaceIndex_.size();
+         ++i) {
+        if (wrapper.isPreciceIdMapped(i))
+            os << i << " -> " << wrapper.getDumuxId(i) << "\n";
     }
 
     os << "\n\n";
     os << "Dumux to preCICE mapping "
        << "\n";
-    for (const auto &v : wrapper.dumuxFaceIndexToPreciceIndex_) {
-        os << v.first << " -> " << wrapper.getPreciceId(v.first) << "\n";
+    if (wrapper.getMappingType() == IndexMappingType::Dense) {
+        for (size_t i = 0; i < wrapper.dumuxFaceIndexToPreciceIndex_.size();
+             ++i) {
+            if (wrapper.isDumuxIdMapped(i))
+                os << i << " -> " << wrapper.getPreciceId(i) << "\n";
+        }
+    } else {
+        for (const auto &v : wrapper.sortedDumuxFaceIndexToPreciceIndex_) {
+            os << v.first << " -> " << v.second << "\n";
+        }
     }
 
     return os;
@@ -0,0 +1,429 @@
+#ifndef DUMUXPRECICE_INTERFACEVERTICES_HH
+#define DUMUXPRECICE_INTERFACEVERTICES_HH
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <numeric>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <dune/grid/common/partitionset.hh>
+
+#include "couplingadapter.hh"
+
+namespace Dumux::Precice
+{
+/*!
+ * @brief Vertices of the coupling mesh owned by the current process.
+ *
+ * The coupling mesh consists of the centers of the sub control volume
+ * faces on the coupling interface. On a distributed grid, only faces of
+ * interior elements are collected. Faces of overlap and ghost elements
+ * are owned by another process and would otherwise be registered with
+ * preCICE more than once.
+ *
+ * The collected interface can be stored in a binary cache file, so that
+ * later runs on the same grid skip the scan over all elements.
+ *
+ * @tparam GridGeometry Type of the DuMuX grid geometry.
+ */
+template<class GridGeometry>
+class InterfaceVertices
+{
+public:
+    /*!
+     * @brief Collects the interface faces of the interior elements.
+     *
+     * @param[in] gridGeometry Grid geometry of the coupled domain.
+     * @param[in] isOnInterface Callable taking a sub control volume face and
+     *            returning true if the face is part of the coupling interface.
+     */
+    template<class IsOnInterface>
+    void update(const GridGeometry &gridGeometry,
+                IsOnInterface &&isOnInterface)
+    {
+        coordinates_.clear();
+        faceIDs_.clear();
+        elementIndices_.clear();
+        elementFaceOffsets_.assign(1, 0);
+
+        auto fvGeometry = localView(gridGeometry);
+        for (const auto &element :
+             elements(gridGeometry.gridView(), Dune::Partitions::interior)) {
+            fvGeometry.bindElement(element);
+
+            for (const auto &scvf : scvfs(fvGeometry)) {
+                if (!isOnInterface(scvf))
+                    continue;
+                faceIDs_.push_back(scvf.index());
+                for (const auto p : scvf.center())
+                    coordinates_.push_back(p);
+            }
+
+            // The faces of an element are stored consecutively
+            if (faceIDs_.size() > elementFaceOffsets_.back()) {
+                elementIndices_.push_back(
+                    gridGeometry.elementMapper().index(element));
+                elementFaceOffsets_.push_back(faceIDs_.size());
+            }
+        }
+    }
+
+    /*!
+     * @brief Reads the interface from a cache file or collects and caches it.
+     *
+     * The cache file is only used if it was written for the same grid,
+     * which is checked by a key computed from the sizes and the bounding
+     * box of the grid, the number of processes and the given cache key.
+     * Since the key does not capture the position of every cell, e.g. of a
+     * graded grid, the cached faces are also compared with the faces of
+     * the grid. An invalid, stale or missing file is overwritten with the
+     * interface collected by update. On distributed grids, every process
+     * uses its own file with the rank appended to the name. With an empty
+     * file name, no cache is used.
+     *
+     * @param[in] gridGeometry Grid geometry of the coupled domain.
+     * @param[in] isOnInterface Callable taking a sub control volume face and
+     *            returning true if the face is part of the coupling interface.
+     * @param[in] cacheFileName Name of the cache file.
+     * @param[in] cacheKey Further parameters the interface depends on, e.g.
+     *            the position of the interface.
+     * @return true The interface was read from the cache file.
+     * @return false The interface was collected (and the cache file written).
+     */
+    template<class IsOnInterface>
+    bool update(const GridGeometry &gridGeometry,
+                IsOnInterface &&isOnInterface,
+                const std::string &cacheFileName,
+                const std::string &cacheKey = "")
+    {
+        if (cacheFileName.empty()) {
+            update(gridGeometry, isOnInterface);
+            return false;
+        }
+
+        const auto &comm = gridGeometry.gridView().comm();
+        const std::string fileName =
+            comm.size() > 1 ? cacheFileName + "." + std::to_string(comm.rank())
+                            : cacheFileName;
+        const std::uint64_t key = gridKey_(gridGeometry, cacheKey);
+        if (readCache_(fileName, key) && matchesGrid_(gridGeometry))
+            return true;
+
+        update(gridGeometry, isOnInterface);
+        writeCache_(fileName, key);
+        return false;
+    }
+
+    /*!
+     * @brief Sets the coupling mesh and creates the index mapping.
+     *
+     * @param[in] couplingInterface The coupling adapter.
+     * @param[in] meshName Name of the mesh.
+     * @param[in] mappingType Storage layout of the index mapping.
+     * @param[in] ordering Order of the vertices passed to preCICE.
+     * @return std::size_t Index of the mesh as returned by CouplingAdapter::setMesh.
+     */
+    std::size_t setMesh(
+        CouplingAdapter &couplingInterface,
+        const std::string &meshName,
+        const IndexMappingType mappingType = IndexMappingType::Dense,
+        const VertexOrdering ordering = VertexOrdering::Input)
+    {
+        const auto meshIndex = couplingInterface.setMesh(
+            meshName, size(), coordinates_, ordering);
+        couplingInterface.createIndexMapping(meshIndex, faceIDs_, mappingType);
+        return meshIndex;
+    }
+
+    /*!
+     * @brief Prints the number of interface vertices of every process and
+     *        the largest memory they hold on a process, see getMemoryUsage.
+     *
+     * Needs to be called on all processes. The output is only written by
+     * the process with rank 0.
+     *
+     * @param[in] comm Communication of the grid, e.g. `gridView.comm()`.
+     * @param os Output stream.
+     */
+    template<class Communication>
+    void reportLoad(const Communication &comm, std::ostream &os) const
+    {
+        const std::size_t localSize = size();
+        std::vector<std::size_t> sizes(comm.size());
+        comm.gather(&localSize, sizes.data(), 1, 0);
+        const std::size_t maximumMemory = comm.max(getMemoryUsage());
+        if (comm.rank() != 0)
+            return;
+
+        const std::size_t total =
+            std::accumulate(sizes.begin(), sizes.end(), std::size_t(0));
+        const std::size_t maximum =
+            *std::max_element(sizes.begin(), sizes.end());
+        os << "Coupling interface vertices per rank:";
+        for (std::size_t r = 0; r < sizes.size(); ++r)
+            os << " " << r << ":" << sizes[r];
+        os << "\n  total: " << total << ", maximum: " << maximum;
+        if (total > 0)
+            os << ", imbalance (maximum / average): "
+               << double(maximum) * sizes.size() / total;
+        os << "\n  memory per rank: at most " << maximumMemory << " bytes\n";
+    }
+
+    /*!
+     * @brief Gets the coordinates of the interface vertices.
+     *
+     * @return const std::vector<double>& Coordinates stored consecutively as
+     *         expected by CouplingAdapter::setMesh.
+     */
+    const std::vector<double> &coordinates() const { return coordinates_; }
+
+    /*!
+     * @brief Gets the identifiers of the interface faces.
+     *
+     * @return const std::vector<int>& Face identifiers according to DuMuX'
+     *         numbering, in the same order as the coordinates.
+     */
+    const std::vector<int> &faceIDs() const { return faceIDs_; }
+
+    /*!
+     * @brief Gets the number of interface vertices of the current process.
+     *
+     * @return std::size_t Number of vertices.
+     */
+    std::size_t size() const { return faceIDs_.size(); }
+
+    /*!
+     * @brief Gets the indices of the elements with interface faces.
+     *
+     * @return const std::vector<std::size_t>& Indices according to the
+     *         element mapper of the grid geometry.
+     */
+    const std::vector<std::size_t> &elementIndices() const
+    {
+        return elementIndices_;
+    }
+
+    /*!
+     * @brief Gets the range of the faces of every element in faceIDs.
+     *
+     * @return const std::vector<std::size_t>& The faces of the i-th element
+     *         are at the positions [offsets[i], offsets[i + 1]) of faceIDs.
+     */
+    const std::vector<std::size_t> &elementFaceOffsets() const
+    {
+        return elementFaceOffsets_;
+    }
+
+    /*!
+     * @brief Gets the memory held by the interface vertices.
+     *
+     * @return std::size_t Number of bytes allocated for the coordinates,
+     *         faces and elements.
+     */
+    std::size_t getMemoryUsage() const
+    {
+        return coordinates_.capacity() * sizeof(double) +
+               faceIDs_.capacity() * sizeof(int) +
+               (elementIndices_.capacity() + elementFaceOffsets_.capacity()) *
+                   sizeof(std::size_t);
+    }
+
+    /*!
+     * @brief Releases the coordinates, faces and elements.
+     *
+     * They are only needed to set up the coupling mesh and the
+     * CoupledElements, afterwards they can be released. The object is empty
+     * until update is called again.
+     */
+    void release()
+    {
+        std::vector<double>().swap(coordinates_);
+        std::vector<int>().swap(faceIDs_);
+        std::vector<std::size_t>().swap(elementIndices_);
+        std::vector<std::size_t>(1, 0).swap(elementFaceOffsets_);
+    }
+
+private:
+    //! Identifies the cache files and their layout.
+    static constexpr std::array<char, 8> cacheMagic_ = {'D', 'P', 'I', 'C',
+                                                        'A', 'C', 'H', '1'};
+
+    /*!
+     * @brief Computes the key identifying the grid in the cache file.
+     *
+     * @param[in] gridGeometry Grid geometry of the coupled domain.
+     * @param[in] cacheKey Further parameters the interface depends on.
+     * @return std::uint64_t FNV-1a hash of the grid's properties.
+     */
+    static std::uint64_t gridKey_(const GridGeometry &gridGeometry,
+                                  const std::string &cacheKey)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        auto add = [&hash](const auto &value) {
+            const auto *bytes = reinterpret_cast<const unsigned char *>(&value);
+            for (std::size_t i = 0; i < sizeof(value); ++i)
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+        };
+        const auto &gridView = gridGeometry.gridView();
+        add(std::uint64_t(gridView.size(0)));
+        add(std::uint64_t(gridView.size(GridGeometry::GridView::dimension)));
+        add(std::uint64_t(gridGeometry.numScvf()));
+        add(std::int64_t(gridView.comm().rank()));
+        add(std::int64_t(gridView.comm().size()));
+        for (const double x : gridGeometry.bBoxMin())
+            add(x);
+        for (const double x : gridGeometry.bBoxMax())
+            add(x);
+        for (const char c : cacheKey)
+            add(c);
+        return hash;
+    }
+
+    /*!
+     * @brief Reads the interface from a cache file.
+     *
+     * @param[in] fileName Name of the cache file.
+     * @param[in] key Key of the current grid.
+     * @return true The file exists and was written for the same grid.
+     * @return false The interface was not read.
+     */
+    bool readCache_(const std::string &fileName, const std::uint64_t key)
+    {
+        std::ifstream ifs(fileName, std::ios::binary);
+        if (!ifs)
+            return false;
+
+        std::array<char, 8> magic;
+        std::uint64_t fileKey, numFaces, numCoordinates, numElements;
+        ifs.read(magic.data(), magic.size());
+        read_(ifs, fileKey);
+        read_(ifs, numFaces);
+        read_(ifs, numCoordinates);
+        read_(ifs, numElements);
+        if (!ifs || magic != cacheMagic_ || fileKey != key)
+            return false;
+
+        coordinates_.resize(numCoordinates);
+        faceIDs_.resize(numFaces);
+        elementIndices_.resize(numElements);
+        elementFaceOffsets_.resize(numElements + 1);
+        read_(ifs, coordinates_);
+        read_(ifs, faceIDs_);
+        read_(ifs, elementIndices_);
+        read_(ifs, elementFaceOffsets_);
+        if (ifs && elementFaceOffsets_.back() == numFaces)
+            return true;
+
+        coordinates_.clear();
+        faceIDs_.clear();
+        elementIndices_.clear();
+        elementFaceOffsets_.assign(1, 0);
+        return false;
+    }
+
+    /*!
+     * @brief Checks that the interface read from a cache file fits the grid.
+     *
+     * The centers are computed in the same way as in update, so a cache
+     * written for the same grid matches exactly.
+     *
+     * @param[in] gridGeometry Grid geometry of the coupled domain.
+     * @return true Every cached face is a face of the cached element with
+     *         the cached center.
+     * @return false The cache was written for a different grid.
+     */
+    bool matchesGrid_(const GridGeometry &gridGeometry) const
+    {
+        const auto numElements = gridGeometry.gridView().size(0);
+        const std::size_t dim = GridGeometry::GridView::dimensionworld;
+        if (coordinates_.size() != dim * faceIDs_.size())
+            return false;
+
+        auto fvGeometry = localView(gridGeometry);
+        for (std::size_t i = 0; i < elementIndices_.size(); ++i) {
+            if (elementIndices_[i] >= std::size_t(numElements))
+                return false;
+            fvGeometry.bindElement(gridGeometry.element(elementIndices_[i]));
+
+            for (auto f = elementFaceOffsets_[i];
+                 f < elementFaceOffsets_[i + 1]; ++f) {
+                bool found = false;
+                for (const auto &scvf : scvfs(fvGeometry)) {
+                    if (int(scvf.index()) != faceIDs_[f])
+                        continue;
+                    const auto center = scvf.center();
+                    found = std::equal(center.begin(), center.end(),
+                                       coordinates_.begin() + dim * f);
+                    break;
+                }
+                if (!found)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    /*!
+     * @brief Writes the interface to a cache file.
+     *
+     * @param[in] fileName Name of the cache file.
+     * @param[in] key Key of the current grid.
+     */
+    void writeCache_(const std::string &fileName, const std::uint64_t key) const
+    {
+        std::ofstream ofs(fileName, std::ios::binary | std::ios::trunc);
+        ofs.write(cacheMagic_.data(), cacheMagic_.size());
+        write_(ofs, key);
+        write_(ofs, std::uint64_t(faceIDs_.size()));
+        write_(ofs, std::uint64_t(coordinates_.size()));
+        write_(ofs, std::uint64_t(elementIndices_.size()));
+        write_(ofs, coordinates_);
+        write_(ofs, faceIDs_);
+        write_(ofs, elementIndices_);
+        write_(ofs, elementFaceOffsets_);
+    }
+
+    template<class T>
+    static void read_(std::istream &is, T &value)
+    {
+        is.read(reinterpret_cast<char *>(&value), sizeof(T));
+    }
+
+    template<class T>
+    static void read_(std::istream &is, std::vector<T> &values)
+    {
+        is.read(reinterpret_cast<char *>(values.data()),
+                values.size() * sizeof(T));
+    }
+
+    template<class T>
+    static void write_(std::ostream &os, const T &value)
+    {
+        os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template<class T>
+    static void write_(std::ostream &os, const std::vector<T> &values)
+    {
+        os.write(reinterpret_cast<const char *>(values.data()),
+                 values.size() * sizeof(T));
+    }
+
+    //! Coordinates of the interface vertices.
+    std::vector<double> coordinates_;
+    //! Identifiers of the interface faces.
+    std::vector<int> faceIDs_;
+    //! Indices of the elements with interface faces.
+    std::vector<std::size_t> elementIndices_;
+    //! Range of the faces of every element in faceIDs_.
+    std::vector<std::size_t> elementFaceOffsets_ = {0};
+};
+
+}  // namespace Dumux::Precice
+
+#endif  // DUMUXPRECICE_INTERFACEVERTICES_HH
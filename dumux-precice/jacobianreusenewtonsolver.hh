@@ -0,0 +1,146 @@
+#ifndef DUMUXPRECICE_JACOBIANREUSENEWTONSOLVER_HH
+#define DUMUXPRECICE_JACOBIANREUSENEWTONSOLVER_HH
+
+#include <cstddef>
+#include <iostream>
+#include <utility>
+
+#include <dumux/common/exceptions.hh>
+#include <dumux/common/parameters.hh>
+#include <dumux/nonlinear/newtonsolver.hh>
+
+namespace Dumux::Precice
+{
+/*!
+ * @brief Newton solver that keeps the Jacobian across its solves.
+ *
+ * In implicit coupling schemes, a stationary sub-problem is solved once per
+ * coupling iteration and only the interface values change in between.
+ * Assembling the Jacobian, in particular with numeric differentiation, is
+ * the dominating cost of the solve. With `Newton.ReuseJacobian` set in the
+ * parameter group of the solver, the Jacobian is assembled once and only
+ * the residual is assembled afterwards, until invalidateJacobian is called.
+ * For linear operators, e.g. Stokes-Darcy, the kept Jacobian is exact and
+ * the solution is the same. For non-linear operators the solver becomes a
+ * chord method. If a solve with a kept Jacobian fails, it is repeated with
+ * a freshly assembled Jacobian.
+ *
+ * Combined with `LinearSolver.ReusePreconditioner` of SelectableLinearSolver,
+ * the factorization of the kept Jacobian is reused, too. Both should be
+ * invalidated once a time window is completed.
+ *
+ * @tparam Assembler Assembler of the sub-problem.
+ * @tparam LinearSolver Linear solver of the sub-problem.
+ */
+template<class Assembler, class LinearSolver>
+class JacobianReuseNewtonSolver : public NewtonSolver<Assembler, LinearSolver>
+{
+    using ParentType = NewtonSolver<Assembler, LinearSolver>;
+    using SolutionVector = typename Assembler::ResidualType;
+
+public:
+    /*!
+     * @brief Creates the solver.
+     *
+     * @param[in] args Arguments passed to the constructor of NewtonSolver.
+     */
+    template<class... Args>
+    explicit JacobianReuseNewtonSolver(Args &&... args)
+        : ParentType(std::forward<Args>(args)...),
+          reuseJacobian_(getParamFromGroup<bool>(
+              this->paramGroup(), "Newton.ReuseJacobian", false))
+    {
+    }
+
+    using ParentType::solve;
+
+    /*!
+     * @brief Solves the non-linear system.
+     *
+     * @param[in,out] uCurrentIter Initial guess and solution.
+     */
+    void solve(SolutionVector &uCurrentIter) override
+    {
+        if (!reuseJacobian_ || !jacobianIsCurrent_) {
+            ParentType::solve(uCurrentIter);
+            return;
+        }
+
+        const SolutionVector uInitial(uCurrentIter);
+        try {
+            ParentType::solve(uCurrentIter);
+        } catch (const NumericalProblem &) {
+            if (this->verbosity() >= 1)
+                std::cout << "Newton solve with kept Jacobian failed, "
+                          << "retrying with a new Jacobian\n";
+            invalidateJacobian();
+            uCurrentIter = uInitial;
+            ParentType::solve(uCurrentIter);
+        }
+    }
+
+    /*!
+     * @brief Assembles the Jacobian and the residual or only the residual.
+     *
+     * @param[in] uCurrentIter The current iterate.
+     */
+    void assembleLinearSystem(const SolutionVector &uCurrentIter) override
+    {
+        if (reuseJacobian_ && jacobianIsCurrent_) {
+            this->assembler().assembleResidual(uCurrentIter);
+            ++numberOfReusedJacobians_;
+            return;
+        }
+
+        ParentType::assembleLinearSystem(uCurrentIter);
+        jacobianIsCurrent_ = reuseJacobian_;
+        ++numberOfJacobianAssemblies_;
+    }
+
+    /*!
+     * @brief Forces the Jacobian to be assembled in the next Newton step.
+     */
+    void invalidateJacobian() { jacobianIsCurrent_ = false; }
+
+    /*!
+     * @brief Checks whether the Jacobian is kept across solves.
+     *
+     * @return true The Jacobian is reused.
+     * @return false The Jacobian is assembled in every Newton step.
+     */
+    bool reusesJacobian() const { return reuseJacobian_; }
+
+    /*!
+     * @brief Gets the number of Newton steps that assembled the Jacobian.
+     *
+     * @return std::size_t Number of Jacobian assemblies.
+     */
+    std::size_t numberOfJacobianAssemblies() const
+    {
+        return numberOfJacobianAssemblies_;
+    }
+
+    /*!
+     * @brief Gets the number of Newton steps that reused the Jacobian.
+     *
+     * @return std::size_t Number of Newton steps with a kept Jacobian.
+     */
+    std::size_t numberOfReusedJacobians() const
+    {
+        return numberOfReusedJacobians_;
+    }
+
+private:
+    //! True if the Jacobian is kept across Newton steps and solves.
+    bool reuseJacobian_;
+    //! True if the assembled Jacobian may be reused.
+    bool jacobianIsCurrent_ = false;
+    //! Number of Newton steps that assembled the Jacobian.
+    std::size_t numberOfJacobianAssemblies_ = 0;
+    //! Number of Newton steps that reused the Jacobian.
+    std::size_t numberOfReusedJacobians_ = 0;
+};
+
+}  // namespace Dumux::Precice
+
+#endif  // DUMUXPRECICE_JACOBIANREUSENEWTONSOLVER_HH
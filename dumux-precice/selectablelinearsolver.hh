@@ -0,0 +1,304 @@
+#ifndef DUMUXPRECICE_SELECTABLELINEARSOLVER_HH
+#define DUMUXPRECICE_SELECTABLELINEARSOLVER_HH
+
+#include <memory>
+#include <string>
+#include <typeinfo>
+
+#include <dune/common/exceptions.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/paamg/amg.hh>
+#include <dune/istl/preconditioners.hh>
+#include <dune/istl/solvers.hh>
+#if HAVE_SUITESPARSE_UMFPACK
+#include <dune/istl/umfpack.hh>
+#endif
+
+#include <dumux/common/exceptions.hh>
+#include <dumux/common/parameters.hh>
+#include <dumux/linear/solver.hh>
+
+namespace Dumux::Precice
+{
+/*!
+ * @brief Linear solvers selectable by SelectableLinearSolver.
+ *
+ * - `Direct`: Sparse LU factorization (UMFPack).
+ * - `ILUBiCGSTAB`: BiCGSTAB preconditioned with ILU(0).
+ * - `ILURestartedGMRes`: Restarted GMRes preconditioned with ILU(0).
+ * - `AMGBiCGSTAB`: BiCGSTAB preconditioned with algebraic multigrid.
+ */
+enum class LinearSolverType {
+    Direct,
+    ILUBiCGSTAB,
+    ILURestartedGMRes,
+    AMGBiCGSTAB
+};
+
+/*!
+ * @brief Linear solver backend selected at run time from the parameters.
+ *
+ * The backend is read from the parameters of the given group:
+ *
+ * - `LinearSolver.Type`: `direct` (default), `ilu-bicgstab`, `ilu-gmres`
+ *   or `amg-bicgstab`.
+ * - `LinearSolver.ReusePreconditioner`: If true (default false), the
+ *   factorization or preconditioner is kept until resetPreconditioner is
+ *   called and reused for all solves in between, e.g. all Newton steps of
+ *   all coupling iterations of a time window. The Jacobian barely changes
+ *   between these solves. A kept factorization is used as preconditioner
+ *   of BiCGSTAB, which typically converges in few steps. If a solve with a
+ *   kept preconditioner fails, the preconditioner is rebuilt once.
+ * - `LinearSolver.GMResRestart`: Restart of GMRes (default 10).
+ *
+ * The common parameters of DuMuX' linear solvers (`LinearSolver.Verbosity`,
+ * `LinearSolver.MaxIterations`, `LinearSolver.ResidualReduction`,
+ * `LinearSolver.PreconditionerRelaxation`) configure the iterative solvers.
+ * The iterative solvers are sequential. The class can be used as linear
+ * solver of DuMuX' NewtonSolver.
+ */
+class SelectableLinearSolver : public LinearSolver
+{
+public:
+    /*!
+     * @brief Reads the backend from the parameters.
+     *
+     * @param[in] paramGroup Parameter group to read the parameters from.
+     */
+    explicit SelectableLinearSolver(const std::string &paramGroup = "")
+        : LinearSolver(paramGroup)
+    {
+        const auto type = getParamFromGroup<std::string>(
+            paramGroup, "LinearSolver.Type", "direct");
+        if (type == "direct")
+            type_ = LinearSolverType::Direct;
+        else if (type == "ilu-bicgstab")
+            type_ = LinearSolverType::ILUBiCGSTAB;
+        else if (type == "ilu-gmres")
+            type_ = LinearSolverType::ILURestartedGMRes;
+        else if (type == "amg-bicgstab")
+            type_ = LinearSolverType::AMGBiCGSTAB;
+        else
+            DUNE_THROW(ParameterException,
+                       "Unknown value for LinearSolver.Type: " << type);
+#if !HAVE_SUITESPARSE_UMFPACK
+        if (type_ == LinearSolverType::Direct)
+            DUNE_THROW(ParameterException,
+                       "LinearSolver.Type direct requires UMFPack");
+#endif
+
+        reusePreconditioner_ = getParamFromGroup<bool>(
+            paramGroup, "LinearSolver.ReusePreconditioner", false);
+        restart_ =
+            getParamFromGroup<int>(paramGroup, "LinearSolver.GMResRestart", 10);
+    }
+
+    /*!
+     * @brief Solves the linear system Ax = b.
+     *
+     * @param[in] A The matrix.
+     * @param[in,out] x Initial guess and solution.
+     * @param[in] b Right-hand side.
+     * @return true The solver converged.
+     * @return false The solver did not converge.
+     */
+    template<class Matrix, class Vector>
+    bool solve(const Matrix &A, Vector &x, const Vector &b)
+    {
+#if HAVE_SUITESPARSE_UMFPACK
+        if (type_ == LinearSolverType::Direct && !reusePreconditioner_) {
+            Dune::UMFPack<Matrix> solver(A, this->verbosity() > 0);
+            Vector bTmp(b);
+            Dune::InverseOperatorResult result;
+            solver.apply(x, bTmp, result);
+            return result.converged;
+        }
+#endif
+
+        using Preconditioner = Dune::Preconditioner<Vector, Vector>;
+        const bool reused = preconditioner_ && reusePreconditioner_ &&
+                            *preconditionerType_ == typeid(Preconditioner);
+        if (!reused)
+            makePreconditioner_<Matrix, Vector>(A);
+
+        auto &preconditioner =
+            *std::static_pointer_cast<Preconditioner>(preconditioner_);
+        bool converged = solveIterative_(A, x, b, preconditioner);
+        if (!converged && reused) {
+            makePreconditioner_<Matrix, Vector>(A);
+            converged = solveIterative_(
+                A, x, b,
+                *std::static_pointer_cast<Preconditioner>(preconditioner_));
+        }
+
+        if (!reusePreconditioner_)
+            resetPreconditioner();
+        return converged;
+    }
+
+    /*!
+     * @brief Computes the norm of a residual.
+     *
+     * @param[in] v The residual.
+     * @return double Euclidean norm of the residual.
+     */
+    template<class Vector>
+    double norm(const Vector &v) const
+    {
+        return v.two_norm();
+    }
+
+    /*!
+     * @brief Discards a kept factorization or preconditioner.
+     *
+     * Should be called once a time window is completed, if the
+     * preconditioner is reused.
+     */
+    void resetPreconditioner()
+    {
+        preconditioner_.reset();
+        preconditionerStorage_.reset();
+        preconditionerType_ = nullptr;
+    }
+
+    /*!
+     * @brief Gets the selected backend.
+     *
+     * @return LinearSolverType The backend.
+     */
+    LinearSolverType type() const { return type_; }
+
+    /*!
+     * @brief Gets the name of the selected backend.
+     *
+     * @return std::string Name of the backend.
+     */
+    std::string name() const
+    {
+        switch (type_) {
+            case LinearSolverType::Direct:
+                return "UMFPack";
+            case LinearSolverType::ILUBiCGSTAB:
+                return "ILU(0) preconditioned BiCGSTAB";
+            case LinearSolverType::ILURestartedGMRes:
+                return "ILU(0) preconditioned restarted GMRes";
+            case LinearSolverType::AMGBiCGSTAB:
+                return "AMG preconditioned BiCGSTAB";
+        }
+        return "unknown";
+    }
+
+private:
+    /*!
+     * @brief Builds the preconditioner of the selected backend for A.
+     *
+     * @param[in] A The matrix.
+     */
+    template<class Matrix, class Vector>
+    void makePreconditioner_(const Matrix &A)
+    {
+        using Preconditioner = Dune::Preconditioner<Vector, Vector>;
+        std::shared_ptr<Preconditioner> preconditioner;
+        switch (type_) {
+            case LinearSolverType::Direct: {
+#if HAVE_SUITESPARSE_UMFPACK
+                // The factorization is used as preconditioner of BiCGSTAB
+                using Factorization = Dune::UMFPack<Matrix>;
+                auto factorization =
+                    std::make_shared<Factorization>(A, this->verbosity() > 0);
+                preconditioner = std::make_shared<
+                    Dune::InverseOperator2Preconditioner<Factorization> >(
+                    *factorization);
+                preconditionerStorage_ = factorization;
+#endif
+                break;
+            }
+            case LinearSolverType::ILUBiCGSTAB:
+            case LinearSolverType::ILURestartedGMRes:
+                preconditioner =
+                    std::make_shared<Dune::SeqILU<Matrix, Vector, Vector> >(
+                        A, this->relaxation());
+                break;
+            case LinearSolverType::AMGBiCGSTAB: {
+                using Operator = Dune::MatrixAdapter<Matrix, Vector, Vector>;
+                using Smoother = Dune::SeqSSOR<Matrix, Vector, Vector>;
+                using Criterion =
+                    Dune::Amg::CoarsenCriterion<Dune::Amg::SymmetricCriterion<
+                        Matrix, Dune::Amg::FirstDiagonal> >;
+                // The hierarchy refers to the matrix, which may be a
+                // temporary of the caller, so it is built on a copy
+                struct Storage {
+                    Matrix matrix;
+                    Operator op;
+                    explicit Storage(const Matrix &M) : matrix(M), op(matrix)
+                    {
+                    }
+                };
+                auto storage = std::make_shared<Storage>(A);
+                typename Dune::Amg::SmootherTraits<Smoother>::Arguments
+                    smootherArgs;
+                smootherArgs.iterations = 1;
+                smootherArgs.relaxationFactor = this->relaxation();
+                Criterion criterion;
+                criterion.setDebugLevel(this->verbosity());
+                using AMG = Dune::Amg::AMG<Operator, Vector, Smoother>;
+                preconditioner = std::make_shared<AMG>(storage->op, criterion,
+                                                       smootherArgs);
+                preconditionerStorage_ = storage;
+                break;
+            }
+        }
+        preconditioner_ = preconditioner;
+        preconditionerType_ = &typeid(Preconditioner);
+    }
+
+    /*!
+     * @brief Solves Ax = b with the iterative solver of the selected backend.
+     *
+     * @param[in] A The matrix.
+     * @param[in,out] x Initial guess and solution.
+     * @param[in] b Right-hand side.
+     * @param[in] preconditioner The preconditioner.
+     * @return true The solver converged.
+     * @return false The solver did not converge.
+     */
+    template<class Matrix, class Vector>
+    bool solveIterative_(const Matrix &A,
+                         Vector &x,
+                         const Vector &b,
+                         Dune::Preconditioner<Vector, Vector> &preconditioner)
+    {
+        Dune::MatrixAdapter<Matrix, Vector, Vector> op(A);
+        Vector bTmp(b);
+        Dune::InverseOperatorResult result;
+        if (type_ == LinearSolverType::ILURestartedGMRes) {
+            Dune::RestartedGMResSolver<Vector> solver(
+                op, preconditioner, this->residReduction(), restart_,
+                this->maxIter(), this->verbosity());
+            solver.apply(x, bTmp, result);
+        } else {
+            Dune::BiCGSTABSolver<Vector> solver(
+                op, preconditioner, this->residReduction(), this->maxIter(),
+                this->verbosity());
+            solver.apply(x, bTmp, result);
+        }
+        return result.converged;
+    }
+
+    //! Selected backend.
+    LinearSolverType type_;
+    //! True if the preconditioner is kept until resetPreconditioner is called.
+    bool reusePreconditioner_;
+    //! Restart of GMRes.
+    int restart_;
+    //! Kept preconditioner, a Dune::Preconditioner of the vector type.
+    std::shared_ptr<void> preconditioner_;
+    //! Objects the preconditioner refers to.
+    std::shared_ptr<void> preconditionerStorage_;
+    //! Type of the kept preconditioner.
+    const std::type_info *preconditionerType_ = nullptr;
+};
+
+}  // namespace Dumux::Precice
+
+#endif  // DUMUXPRECICE_SELECTABLELINEARSOLVER_HH
@@ -0,0 +1,106 @@
+#ifndef DUMUXPRECICE_SOLUTIONCHECKPOINT_HH
+#define DUMUXPRECICE_SOLUTIONCHECKPOINT_HH
+
+namespace Dumux::Precice
+{
+/*!
+ * @brief What happens to the solution when a checkpoint is read.
+ *
+ * - `Full`: The stored solution is copied back and the grid variables are
+ *   reinitialized from it. This is the correct choice for instationary
+ *   problems.
+ * - `KeepIterate`: The current iterate is kept and neither the solution
+ *   nor the grid variables are touched. This is only valid for stationary
+ *   sub-problems where the checkpoint merely provides the initial guess of
+ *   the next coupling iteration. The last iterate usually is a better guess
+ *   and the grid variables are already consistent with it after the
+ *   Newton solve.
+ */
+enum class CheckpointRestoreMode { Full, KeepIterate };
+
+/*!
+ * @brief Storage for the solution checkpoint of implicit coupling schemes.
+ *
+ * The checkpoint is allocated once, when the object is created, and reused
+ * afterwards. Storing and restoring copy into the existing memory instead
+ * of creating new solution vectors.
+ *
+ * @tparam SolutionVector Type of the solution vector.
+ */
+template<class SolutionVector>
+class SolutionCheckpoint
+{
+public:
+    /*!
+     * @brief Creates the checkpoint storage.
+     *
+     * No storage is allocated in `KeepIterate` mode.
+     *
+     * @param[in] sol Solution vector used to size the storage.
+     * @param[in] mode Behavior when the checkpoint is read.
+     */
+    explicit SolutionCheckpoint(
+        const SolutionVector &sol,
+        const CheckpointRestoreMode mode = CheckpointRestoreMode::Full)
+        : checkpoint_(mode == CheckpointRestoreMode::Full ? sol
+                                                          : SolutionVector()),
+          mode_(mode)
+    {
+    }
+
+    /*!
+     * @brief Stores the solution in the checkpoint.
+     *
+     * Nothing is copied in `KeepIterate` mode since the stored solution
+     * would never be restored.
+     *
+     * @param[in] sol Solution vector to store.
+     */
+    void store(const SolutionVector &sol)
+    {
+        if (mode_ == CheckpointRestoreMode::KeepIterate)
+            return;
+        checkpoint_ = sol;
+    }
+
+    /*!
+     * @brief Restores the solution and the grid variables from the checkpoint.
+     *
+     * @param[in,out] sol Solution vector to restore.
+     * @param[in,out] gridVariables Grid variables that are reinitialized
+     *                from the restored solution.
+     */
+    template<class GridVariables>
+    void restore(SolutionVector &sol, GridVariables &gridVariables) const
+    {
+        if (mode_ == CheckpointRestoreMode::KeepIterate)
+            return;
+        sol = checkpoint_;
+        // Updates the current variables and copies them to the previous ones
+        gridVariables.init(sol);
+    }
+
+    /*!
+     * @brief Gets the stored solution.
+     *
+     * @return const SolutionVector& The stored solution. Only meaningful in `Full` mode.
+     */
+    const SolutionVector &solution() const { return checkpoint_; }
+
+    /*!
+     * @brief Gets the behavior when the checkpoint is read.
+     *
+     * @return CheckpointRestoreMode The restore mode.
+     */
+    CheckpointRestoreMode mode() const { return mode_; }
+
+private:
+    //! Stored solution.
+    SolutionVector checkpoint_;
+    //! Behavior when the checkpoint is read.
+    CheckpointRestoreMode mode_;
+};
+
+}  // namespace Dumux::Precice
+
+#endif  // DUMUXPRECICE_SOLUTIONCHECKPOINT_HH
@@ -0,0 +1,80 @@
+#ifndef DUMUXPRECICE_SOLUTIONSNAPSHOT_HH
+#define DUMUXPRECICE_SOLUTIONSNAPSHOT_HH
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <dune/common/hybridutilities.hh>
+#include <dune/common/typetraits.hh>
+
+namespace Dumux::Precice
+{
+namespace Impl
+{
+template<class Vector>
+void flattenSolution(const Vector &v, std::vector<double> &values)
+{
+    if constexpr (Dune::IsNumber<Vector>::value)
+        values.push_back(v);
+    else
+        Dune::Hybrid::forEach(
+            Dune::range(Dune::Hybrid::size(v)),
+            [&](auto i) { flattenSolution(v[i], values); });
+}
+
+template<class Vector>
+void restoreSolution(Vector &v,
+                     const std::vector<double> &values,
+                     std::size_t &position)
+{
+    if constexpr (Dune::IsNumber<Vector>::value) {
+        if (position == values.size())
+            throw std::runtime_error(
+                "The snapshot is smaller than the solution vector!");
+        v = values[position++];
+    } else
+        Dune::Hybrid::forEach(
+            Dune::range(Dune::Hybrid::size(v)),
+            [&](auto i) { restoreSolution(v[i], values, position); });
+}
+}  // namespace Impl
+
+/*!
+ * @brief Copies a solution vector into a flat vector, e.g. to write it with
+ *        CouplingAdapter::writeSnapshot.
+ *
+ * Nested block vectors and multi-type block vectors, e.g. of staggered
+ * discretizations, are supported.
+ *
+ * @param[in] sol The solution vector.
+ * @return std::vector<double> All entries of the solution vector.
+ */
+template<class SolutionVector>
+std::vector<double> flattenSolution(const SolutionVector &sol)
+{
+    std::vector<double> values;
+    Impl::flattenSolution(sol, values);
+    return values;
+}
+
+/*!
+ * @brief Copies a flat vector back into a solution vector.
+ *
+ * @param[in,out] sol Solution vector, which must have the size of the
+ *                solution vector values was created from.
+ * @param[in] values Entries created by flattenSolution.
+ */
+template<class SolutionVector>
+void restoreSolution(SolutionVector &sol, const std::vector<double> &values)
+{
+    std::size_t position = 0;
+    Impl::restoreSolution(sol, values, position);
+    if (position != values.size())
+        throw std::runtime_error(
+            "The snapshot is larger than the solution vector!");
+}
+
+}  // namespace Dumux::Precice
+
+#endif  // DUMUXPRECICE_SOLUTIONSNAPSHOT_HH
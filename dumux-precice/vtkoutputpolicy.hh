@@ -0,0 +1,129 @@
+#ifndef DUMUXPRECICE_VTKOUTPUTPOLICY_HH
+#define DUMUXPRECICE_VTKOUTPUTPOLICY_HH
+
+#include <cstddef>
+#include <string>
+
+#include <dune/common/exceptions.hh>
+#include <dune/grid/io/file/vtk/common.hh>
+
+#include <dumux/common/exceptions.hh>
+#include <dumux/common/parameters.hh>
+
+namespace Dumux::Precice
+{
+/*!
+ * @brief Decides when the VTK output of a coupled simulation is written.
+ *
+ * In implicit coupling schemes, a time window consists of several coupling
+ * iterations and all but the last one are rejected. Writing output for
+ * every iteration puts disk I/O on the critical path of the coupling and
+ * stalls the other participant, too. The policy is read from the
+ * parameters of the given group:
+ *
+ * - `Vtk.CouplingOutput`: `EveryIteration` (default) writes the output of
+ *   every coupling iteration and of every completed time window.
+ *   `TimeWindows` only writes the output of completed time windows.
+ * - `Vtk.TimeWindowInterval`: Only every n-th completed time window is
+ *   written (default 1).
+ * - `Vtk.OutputFormat`: `ascii` (default), `base64`, `appendedraw` or
+ *   `appendedbase64`. The binary formats are considerably faster to write
+ *   and read. On distributed grids DuMuX writes a parallel `pvtu` file in
+ *   any case.
+ */
+class VtkOutputPolicy
+{
+public:
+    /*!
+     * @brief Reads the policy from the parameters.
+     *
+     * @param[in] paramGroup Parameter group to read the policy from.
+     */
+    explicit VtkOutputPolicy(const std::string &paramGroup = "")
+    {
+        const auto frequency = getParamFromGroup<std::string>(
+            paramGroup, "Vtk.CouplingOutput", "EveryIteration");
+        if (frequency == "EveryIteration")
+            writeIterations_ = true;
+        else if (frequency == "TimeWindows")
+            writeIterations_ = false;
+        else
+            DUNE_THROW(ParameterException,
+                       "Unknown value for Vtk.CouplingOutput: " << frequency);
+
+        const int interval =
+            getParamFromGroup<int>(paramGroup, "Vtk.TimeWindowInterval", 1);
+        if (interval < 1)
+            DUNE_THROW(ParameterException,
+                       "Vtk.TimeWindowInterval must be positive");
+        timeWindowInterval_ = interval;
+
+        const auto format = getParamFromGroup<std::string>(
+            paramGroup, "Vtk.OutputFormat", "ascii");
+        if (format == "ascii")
+            outputType_ = Dune::VTK::ascii;
+        else if (format == "base64")
+            outputType_ = Dune::VTK::base64;
+        else if (format == "appendedraw")
+            outputType_ = Dune::VTK::appendedraw;
+        else if (format == "appendedbase64")
+            outputType_ = Dune::VTK::appendedbase64;
+        else
+            DUNE_THROW(ParameterException,
+                       "Unknown value for Vtk.OutputFormat: " << format);
+    }
+
+    /*!
+     * @brief Checks whether the output of a coupling iteration is written.
+     *
+     * @return true The output of every coupling iteration is written.
+     * @return false Only completed time windows are written.
+     */
+    bool writeIteration() const { return writeIterations_; }
+
+    /*!
+     * @brief Checks whether the output of a completed time window is written.
+     *
+     * Must be called exactly once per completed time window.
+     *
+     * @return true The output of the time window is written.
+     * @return false The time window is skipped.
+     */
+    bool writeTimeWindow()
+    {
+        ++completedTimeWindows_;
+        return completedTimeWindows_ % timeWindowInterval_ == 0;
+    }
+
+    /*!
+     * @brief Continues the count of the time windows of a resumed run.
+     *
+     * @param[in] completedTimeWindows Number of time windows completed
+     *            before the run was resumed.
+     */
+    void setCompletedTimeWindows(const std::size_t completedTimeWindows)
+    {
+        completedTimeWindows_ = completedTimeWindows;
+    }
+
+    /*!
+     * @brief Gets the format the output is written in.
+     *
+     * @return Dune::VTK::OutputType Format to pass to the VTK writer.
+     */
+    Dune::VTK::OutputType outputType() const { return outputType_; }
+
+private:
+    //! True if the output of every coupling iteration is written.
+    bool writeIterations_;
+    //! Only every n-th completed time window is written.
+    std::size_t timeWindowInterval_;
+    //! Number of time windows completed so far.
+    std::size_t completedTimeWindows_ = 0;
+    //! Format of the output.
+    Dune::VTK::OutputType outputType_;
+};
+
+}  // namespace Dumux::Precice
+
+#endif  // DUMUXPRECICE_VTKOUTPUTPOLICY_HH
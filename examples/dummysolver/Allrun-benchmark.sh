@@ -0,0 +1,35 @@
+#!/usr/bin/env sh
+# Runs the throughput benchmark of the dummy solver.
+#
+# The benchmark is configured via environment variables:
+# - VERTICES: Number of coupling mesh vertices per rank (default 10000)
+# - SCALARS: Number of scalar quantities per direction (default 1)
+# - VECTORS: Number of vector quantities per direction (default 1)
+# - WINDOWS: Number of time windows (default 100)
+# - RANKS: Number of MPI ranks per solver (default 1)
+
+set -e -u
+
+VERTICES=${VERTICES:-10000}
+SCALARS=${SCALARS:-1}
+VECTORS=${VECTORS:-1}
+WINDOWS=${WINDOWS:-100}
+RANKS=${RANKS:-1}
+
+CONFIG=precice-dummy-solver-benchmark-config.xml
+./generate-benchmark-config.sh "${SCALARS}" "${VECTORS}" "${WINDOWS}" ${CONFIG}
+
+rm -rf precice-run/
+
+OPTIONS="-preCICE.ConfigFileName ${CONFIG} -Benchmark.NumberOfVertices ${VERTICES} -Benchmark.NumberOfScalarQuantities ${SCALARS} -Benchmark.NumberOfVectorQuantities ${VECTORS}"
+
+mpirun -np "${RANKS}" ./dumuxprecice_dummysolver_benchmark -preCICE.SolverName SolverOne -preCICE.MeshName MeshOne ${OPTIONS} > Benchmark_One.out 2>&1 &
+SOLVER_ONE_ID=$!
+
+mpirun -np "${RANKS}" ./dumuxprecice_dummysolver_benchmark -preCICE.SolverName SolverTwo -preCICE.MeshName MeshTwo ${OPTIONS} > Benchmark_Two.out 2>&1 &
+SOLVER_TWO_ID=$!
+
+wait ${SOLVER_ONE_ID}
+wait ${SOLVER_TWO_ID}
+
+grep -A 4 "^Benchmark" Benchmark_One.out Benchmark_Two.out
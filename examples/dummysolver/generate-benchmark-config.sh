@@ -0,0 +1,85 @@
+#!/usr/bin/env sh
+# Writes the preCICE configuration for main_dummysolver_benchmark.cc.
+#
+# Usage: generate-benchmark-config.sh NUM_SCALAR NUM_VECTOR NUM_WINDOWS [FILE]
+
+set -e -u
+
+NUM_SCALAR=${1}
+NUM_VECTOR=${2}
+NUM_WINDOWS=${3}
+FILE=${4:-precice-dummy-solver-benchmark-config.xml}
+
+# Prints "KIND NAME" for all quantities written by the given solver (One or Two).
+quantities() {
+    i=0
+    while [ ${i} -lt "${NUM_SCALAR}" ]; do
+        echo "scalar scalarData${1}${i}"
+        i=$((i + 1))
+    done
+    i=0
+    while [ ${i} -lt "${NUM_VECTOR}" ]; do
+        echo "vector vectorData${1}${i}"
+        i=$((i + 1))
+    done
+}
+
+# Prints the lines of a participant using the given mesh.
+participant_data() {
+    quantities "${1}" | while read -r KIND NAME; do
+        echo "      <write-data name=\"${NAME}\" mesh=\"${3}\" />"
+    done
+    quantities "${2}" | while read -r KIND NAME; do
+        echo "      <read-data name=\"${NAME}\" mesh=\"${3}\" />"
+    done
+}
+
+{
+    echo '<?xml version="1.0"?>'
+    echo ''
+    echo '<precice-configuration>'
+    echo '  <log>'
+    echo '    <sink type="stream" output="stdout" filter="%Severity% > info" enabled="true" />'
+    echo '  </log>'
+    echo ''
+    echo '  <solver-interface dimensions="3" >'
+    for SOLVER in One Two; do
+        quantities ${SOLVER} | while read -r KIND NAME; do
+            echo "    <data:${KIND} name=\"${NAME}\" />"
+        done
+    done
+    for MESH in MeshOne MeshTwo; do
+        echo "    <mesh name=\"${MESH}\">"
+        for SOLVER in One Two; do
+            quantities ${SOLVER} | while read -r KIND NAME; do
+                echo "      <use-data name=\"${NAME}\" />"
+            done
+        done
+        echo '    </mesh>'
+    done
+    echo '    <participant name="SolverOne">'
+    echo '      <use-mesh name="MeshOne" provide="yes"/>'
+    participant_data One Two MeshOne
+    echo '    </participant>'
+    echo '    <participant name="SolverTwo">'
+    echo '      <use-mesh name="MeshOne" from="SolverOne"/>'
+    echo '      <use-mesh name="MeshTwo" provide="yes"/>'
+    echo '      <mapping:nearest-neighbor direction="write" from="MeshTwo" to="MeshOne" constraint="conservative"/>'
+    echo '      <mapping:nearest-neighbor direction="read" from="MeshOne" to="MeshTwo" constraint="consistent" />'
+    participant_data Two One MeshTwo
+    echo '    </participant>'
+    echo '    <m2n:sockets from="SolverOne" to="SolverTwo" exchange-directory="."/>'
+    echo '    <coupling-scheme:parallel-explicit>'
+    echo '      <participants first="SolverOne" second="SolverTwo" />'
+    echo "      <max-time-windows value=\"${NUM_WINDOWS}\" />"
+    echo '      <time-window-size value="1.0" />'
+    quantities One | while read -r KIND NAME; do
+        echo "      <exchange data=\"${NAME}\" mesh=\"MeshOne\" from=\"SolverOne\" to=\"SolverTwo\" />"
+    done
+    quantities Two | while read -r KIND NAME; do
+        echo "      <exchange data=\"${NAME}\" mesh=\"MeshOne\" from=\"SolverTwo\" to=\"SolverOne\" />"
+    done
+    echo '    </coupling-scheme:parallel-explicit>'
+    echo '  </solver-interface>'
+    echo '</precice-configuration>'
+} > "${FILE}"
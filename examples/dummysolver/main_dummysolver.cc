@@ -9,6 +9,7 @@
 
 #include <iostream>
 
+#include <dune/common/fvector.hh>
 #include <dune/common/parallel/mpihelper.hh>
 #include <dune/common/timer.hh>
 #include <dune/istl/io.hh>
@@ -44,7 +45,7 @@ try {
     const std::string meshName =
         getParamFromGroup<std::string>("preCICE", "MeshName");
 
-    auto &couplingInterface = Dumux::Precice::CouplingAdapter::getInstance();
+    Dumux::Precice::CouplingAdapter couplingInterface;
     couplingInterface.announceSolver(solverName, preciceConfigFilename,
                                      mpiHelper.rank(), mpiHelper.size());
 
@@ -91,13 +92,13 @@ try {
     std::cout << "DUMMY (" << mpiHelper.rank() << "): Create index mapping\n";
     couplingInterface.createIndexMapping(dumuxVertexIDs);
 
-    const int readScalarDataID =
+    const auto readScalarDataID =
         couplingInterface.announceScalarQuantity(scalarDataReadName);
-    const int writeScalarDataID =
+    const auto writeScalarDataID =
         couplingInterface.announceScalarQuantity(scalarDataWriteName);
-    const int readVectorDataID =
+    const auto readVectorDataID =
         couplingInterface.announceVectorQuantity(vectorDataReadName);
-    const int writeVectorDataID =
+    const auto writeVectorDataID =
         couplingInterface.announceVectorQuantity(vectorDataWriteName);
 
     if (couplingInterface.hasToWriteInitialData()) {
@@ -106,12 +107,11 @@ try {
         // Scalar data
         couplingInterface.writeQuantityVector(writeScalarDataID,
                                               writeScalarData);
-        couplingInterface.writeScalarQuantityToOtherSolver(writeScalarDataID);
         // Vector data
         couplingInterface.writeQuantityVector(writeVectorDataID,
                                               writeVectorData);
-        couplingInterface.writeQuantityToOtherSolver(
-            writeVectorDataID, Dumux::Precice::QuantityType::Vector);
+        couplingInterface.writeQuantitiesToOtherSolver(
+            {writeScalarDataID, writeVectorDataID});
         couplingInterface.announceInitialDataWritten();
     }
     std::cout << "DUMMY (" << mpiHelper.rank() << "): Exchange initial\n";
@@ -121,10 +121,8 @@ try {
     if (solverName == "SolverOne") {
         std::cout << "DUMMY (" << mpiHelper.rank()
                   << "): Reading initial data\n";
-        couplingInterface.readQuantityFromOtherSolver(
-            readScalarDataID, Dumux::Precice::QuantityType::Scalar);
-        couplingInterface.readQuantityFromOtherSolver(
-            readVectorDataID, Dumux::Precice::QuantityType::Vector);
+        couplingInterface.readQuantitiesFromOtherSolver(
+            {readScalarDataID, readVectorDataID});
 
         const std::vector<double> &readScalarQuantity =
             couplingInterface.getQuantityVector(readScalarDataID);
@@ -179,10 +177,8 @@ try {
 
         //Read data
         std::cout << "DUMMY (" << mpiHelper.rank() << "): Reading data\n";
-        couplingInterface.readQuantityFromOtherSolver(
-            readScalarDataID, Dumux::Precice::QuantityType::Scalar);
-        couplingInterface.readQuantityFromOtherSolver(
-            readVectorDataID, Dumux::Precice::QuantityType::Vector);
+        couplingInterface.readQuantitiesFromOtherSolver(
+            {readScalarDataID, readVectorDataID});
 
         // Check data
         if (iter > 0) {
@@ -239,14 +235,15 @@ try {
             couplingInterface.writeScalarQuantityOnFace(
                 writeScalarDataID, dumuxVertexIDs[i], value);
         }
-        couplingInterface.writeQuantityToOtherSolver(
-            writeScalarDataID, Dumux::Precice::QuantityType::Scalar);
 
-        // Write vector data
-        couplingInterface.writeQuantityVector(writeVectorDataID,
-                                              writeVectorData);
-        couplingInterface.writeQuantityToOtherSolver(
-            writeVectorDataID, Dumux::Precice::QuantityType::Vector);
+        // Write vector data via DuMuX ID <-> preCICE ID mapping
+        for (int i = 0; i < numberOfVertices; i++) {
+            const Dune::FieldVector<double, 3> value(i + iter);
+            couplingInterface.writeVectorQuantityOnFace<3>(
+                writeVectorDataID, dumuxVertexIDs[i], value);
+        }
+        couplingInterface.writeQuantitiesToOtherSolver(
+            {writeScalarDataID, writeVectorDataID});
 
         preciceDt = couplingInterface.advance(preciceDt);
 
@@ -0,0 +1,187 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*!
+ * \file main_dummysolver_benchmark.cc
+ *
+ * \brief Throughput benchmark of the coupling adapter and preCICE.
+ *
+ * Two instances of this solver exchange a configurable number of scalar
+ * and vector quantities on a coupling mesh of configurable size without
+ * doing any work in between. The exchange bandwidth and the latency per
+ * call to advance are reported at the end. The preCICE configuration
+ * matching the parameters is created by `generate-benchmark-config.sh`,
+ * `Allrun-benchmark.sh` runs a complete benchmark.
+ *
+ * Parameters:
+ * - `Benchmark.NumberOfVertices`: Number of coupling mesh vertices per rank.
+ * - `Benchmark.NumberOfScalarQuantities`: Number of scalar quantities
+ *   written (and read) by each solver.
+ * - `Benchmark.NumberOfVectorQuantities`: Number of vector quantities
+ *   written (and read) by each solver.
+ * - `Benchmark.Verbose`: Print progress of every coupling iteration.
+ */
+#include <config.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+
+#include <dumux/common/dumuxmessage.hh>
+#include <dumux/common/parameters.hh>
+
+#include "dumux-precice/couplingadapter.hh"
+
+int main(int argc, char **argv)
+try {
+    using namespace Dumux;
+
+    // initialize MPI, finalize is done automatically on exit
+    const auto &mpiHelper = Dune::MPIHelper::instance(argc, argv);
+    const auto comm = mpiHelper.getCommunication();
+
+    // parse command line arguments and input file
+    Parameters::init(argc, argv);
+
+    const std::string solverName =
+        getParamFromGroup<std::string>("preCICE", "SolverName");
+    const std::string preciceConfigFilename =
+        getParamFromGroup<std::string>("preCICE", "ConfigFileName");
+    const std::string meshName =
+        getParamFromGroup<std::string>("preCICE", "MeshName");
+
+    const int numberOfVertices =
+        getParam<int>("Benchmark.NumberOfVertices", 1000);
+    const int numberOfScalarQuantities =
+        getParam<int>("Benchmark.NumberOfScalarQuantities", 1);
+    const int numberOfVectorQuantities =
+        getParam<int>("Benchmark.NumberOfVectorQuantities", 1);
+    const bool verbose = getParam<bool>("Benchmark.Verbose", false);
+
+    Dumux::Precice::CouplingAdapter couplingInterface;
+    couplingInterface.announceSolver(solverName, preciceConfigFilename,
+                                     mpiHelper.rank(), mpiHelper.size());
+    const int dimensions = couplingInterface.getDimensions();
+
+    // Vertices on a line, the ranks own consecutive segments
+    std::vector<double> vertices(numberOfVertices * dimensions, 0.);
+    std::vector<int> dumuxVertexIDs(numberOfVertices);
+    const int firstVertex = mpiHelper.rank() * numberOfVertices;
+    for (int i = 0; i < numberOfVertices; i++) {
+        vertices[i * dimensions] = firstVertex + i;
+        dumuxVertexIDs[i] = i;
+    }
+
+    const auto meshIndex =
+        couplingInterface.setMesh(meshName, numberOfVertices, vertices);
+    couplingInterface.createIndexMapping(meshIndex, dumuxVertexIDs);
+    double preciceDt = couplingInterface.initialize();
+
+    const std::string writeSuffix = (solverName == "SolverOne") ? "One" : "Two";
+    const std::string readSuffix = (solverName == "SolverOne") ? "Two" : "One";
+    std::vector<size_t> writeDataIDs;
+    std::vector<size_t> readDataIDs;
+    for (int i = 0; i < numberOfScalarQuantities; i++) {
+        const auto index = std::to_string(i);
+        writeDataIDs.push_back(couplingInterface.announceScalarQuantity(
+            meshIndex, "scalarData" + writeSuffix + index));
+        readDataIDs.push_back(couplingInterface.announceScalarQuantity(
+            meshIndex, "scalarData" + readSuffix + index));
+    }
+    for (int i = 0; i < numberOfVectorQuantities; i++) {
+        const auto index = std::to_string(i);
+        writeDataIDs.push_back(couplingInterface.announceVectorQuantity(
+            meshIndex, "vectorData" + writeSuffix + index));
+        readDataIDs.push_back(couplingInterface.announceVectorQuantity(
+            meshIndex, "vectorData" + readSuffix + index));
+    }
+
+    // Values exchanged per coupling iteration by this rank in each direction
+    size_t valuesPerIteration = 0;
+    for (const auto dataID : writeDataIDs) {
+        std::vector<double> values =
+            couplingInterface.getQuantityVector(dataID);
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = firstVertex + i;
+        couplingInterface.writeQuantityVector(dataID, values);
+        valuesPerIteration += values.size();
+    }
+
+    if (couplingInterface.hasToWriteInitialData()) {
+        couplingInterface.writeQuantitiesToOtherSolver(writeDataIDs);
+        couplingInterface.announceInitialDataWritten();
+    }
+    couplingInterface.initializeData();
+
+    Dune::Timer timer;
+    while (couplingInterface.isCouplingOngoing()) {
+        if (couplingInterface.hasToWriteIterationCheckpoint())
+            couplingInterface.announceIterationCheckpointWritten();
+
+        couplingInterface.readQuantitiesFromOtherSolver(readDataIDs);
+        couplingInterface.writeQuantitiesToOtherSolver(writeDataIDs);
+        preciceDt = couplingInterface.advance(preciceDt);
+
+        if (couplingInterface.hasToReadIterationCheckpoint())
+            couplingInterface.announceIterationCheckpointRead();
+
+        if (verbose)
+            std::cout << "DUMMY (" << mpiHelper.rank() << "): Iteration "
+                      << couplingInterface.getStatistics().numberOfIterations()
+                      << " done\n";
+    }
+    const double wallTime = timer.elapsed();
+    couplingInterface.finalize();
+
+    // The slowest rank determines the time of the exchange
+    using Phase = Dumux::Precice::CouplingPhase;
+    const auto &statistics = couplingInterface.getStatistics();
+    const size_t iterations = statistics.numberOfIterations();
+    const double advanceTime =
+        comm.max(statistics.phase(Phase::Advance).time);
+    const double readTime =
+        comm.max(statistics.phase(Phase::ReadBlockData).time);
+    const double writeTime =
+        comm.max(statistics.phase(Phase::WriteBlockData).time);
+    const double maxWallTime = comm.max(wallTime);
+    const size_t totalVertices = comm.sum(size_t(numberOfVertices));
+    const size_t totalValues = comm.sum(valuesPerIteration);
+
+    if (mpiHelper.rank() == 0 && iterations > 0) {
+        // Every value is written by one solver and read by the other
+        const double bytesPerIteration = 2. * totalValues * sizeof(double);
+        std::cout << "Benchmark " << solverName << ": " << mpiHelper.size()
+                  << " ranks, " << totalVertices << " vertices, "
+                  << numberOfScalarQuantities << " scalar and "
+                  << numberOfVectorQuantities
+                  << " vector quantities per direction\n"
+                  << "  coupling iterations: " << iterations
+                  << ", time windows: " << statistics.timeWindows().size()
+                  << ", wall time: " << maxWallTime << " s\n"
+                  << "  latency per advance: " << 1e3 * advanceTime / iterations
+                  << " ms\n"
+                  << "  block read/write per iteration: "
+                  << 1e3 * readTime / iterations << " ms / "
+                  << 1e3 * writeTime / iterations << " ms\n"
+                  << "  exchange bandwidth: "
+                  << bytesPerIteration * iterations / advanceTime / 1e6
+                  << " MB/s\n";
+    }
+
+    return 0;
+}  // end main
+catch (Dumux::ParameterException &e) {
+    std::cerr << std::endl << e << " ---> Abort!" << std::endl;
+    return 1;
+} catch (Dune::Exception &e) {
+    std::cerr << "Dune reported error: " << e << " ---> Abort!" << std::endl;
+    return 3;
+} catch (std::runtime_error &e) {
+    std::cerr << std::endl << e.what() << " ---> Abort!" << std::endl;
+    return 4;
+} catch (...) {
+    std::cerr << "Unknown exception thrown! ---> Abort!" << std::endl;
+    return 5;
+}
@@ -36,6 +36,7 @@
 #include <dumux/freeflow/navierstokes/model.hh>
 #include <dumux/freeflow/navierstokes/problem.hh>
 
+#include <dumux-precice/coupledfacevalues.hh>
 #include <dumux-precice/couplingadapter.hh>
 
 namespace Dumux
@@ -124,10 +125,11 @@ class StokesSubProblem : public NavierStokesProblem<TypeTag>
     using FluidSystem = GetPropType<TypeTag, Properties::FluidSystem>;
 
 public:
-    StokesSubProblem(std::shared_ptr<const GridGeometry> gridGeometry)
+    StokesSubProblem(std::shared_ptr<const GridGeometry> gridGeometry,
+                     Dumux::Precice::CouplingAdapter &couplingInterface)
         : ParentType(gridGeometry, "FreeFlow"),
           eps_(1e-6),
-          couplingInterface_(Dumux::Precice::CouplingAdapter::getInstance()),
+          couplingInterface_(couplingInterface),
           pressureId_(0),
           velocityId_(0),
           dataIdsWereSet_(false)
@@ -188,7 +190,7 @@ public:
             values.setDirichlet(Indices::pressureIdx);
         }
         // coupling interface
-        else if (couplingInterface_.isCoupledEntity(faceId)) {
+        else if (coupledFaceValues_.isCoupled(faceId)) {
             // // TODO do preCICE stuff in analogy to heat transfer
             assert(dataIdsWereSet_);
             //TODO What do I want to do here?
@@ -222,9 +224,9 @@ public:
         values = initialAtPos(scvf.center());
 
         const auto faceId = scvf.index();
-        if (couplingInterface_.isCoupledEntity(faceId)) {
+        if (coupledFaceValues_.isCoupled(faceId)) {
             values[Indices::velocityYIdx] =
-                couplingInterface_.getScalarQuantityOnFace(velocityId_, faceId);
+                coupledFaceValues_.value(velocityId_, faceId);
         }
 
         return values;
@@ -250,7 +252,7 @@ public:
 
         assert(dataIdsWereSet_);
         const auto faceId = scvf.index();
-        if (couplingInterface_.isCoupledEntity(faceId)) {
+        if (coupledFaceValues_.isCoupled(faceId)) {
             const Scalar density =
                 1000;  // TODO how to handle compressible fluids?
             values[Indices::conti0EqIdx] = density *
@@ -258,8 +260,7 @@ public:
                                            scvf.directionSign();
             values[Indices::momentumYBalanceIdx] =
                 scvf.directionSign() *
-                (couplingInterface_.getScalarQuantityOnFace(pressureId_,
-                                                            faceId) -
+                (coupledFaceValues_.value(pressureId_, faceId) -
                  initialAtPos(scvf.center())[Indices::pressureIdx]);
         }
         return values;
@@ -363,6 +364,19 @@ public:
         pressureId_ = couplingInterface_.getIdFromName("Pressure");
         velocityId_ = couplingInterface_.getIdFromName("Velocity");
         dataIdsWereSet_ = true;
+        coupledFaceValues_.setCoupledFaces(couplingInterface_,
+                                           this->gridGeometry().numScvf());
+        updateCoupledFaceValues();
+    }
+
+    /*!
+     * \brief Copies the coupling quantities on the interface from the
+     *        coupling adapter, must be called after every read.
+     */
+    void updateCoupledFaceValues()
+    {
+        coupledFaceValues_.update(couplingInterface_, pressureId_);
+        coupledFaceValues_.update(couplingInterface_, velocityId_);
     }
 
     // \}
@@ -395,6 +409,7 @@ private:
     size_t pressureId_;
     size_t velocityId_;
     bool dataIdsWereSet_;
+    Dumux::Precice::CoupledFaceValues coupledFaceValues_;
 
     mutable std::vector<Scalar> analyticalVelocityX_;
 };
@@ -25,6 +25,8 @@
 
 #include <ctime>
 #include <iostream>
+#include <limits>
+#include <sstream>
 
 #include <dune/common/parallel/mpihelper.hh>
 #include <dune/common/timer.hh>
@@ -40,13 +42,20 @@
 #include <dumux/io/grid/gridmanager.hh>
 #include <dumux/io/staggeredvtkoutputmodule.hh>
 #include <dumux/io/vtkoutputmodule.hh>
-#include <dumux/linear/seqsolverbackend.hh>
 
 #include <dumux/assembly/staggeredfvassembler.hh>
 #include <dumux/nonlinear/newtonsolver.hh>
 
 #include "ffproblem-reversed.hh"
 
+#include "dumux-precice/coupledelements.hh"
+#include "dumux-precice/interfacevertices.hh"
+#include "dumux-precice/jacobianreusenewtonsolver.hh"
+#include "dumux-precice/selectablelinearsolver.hh"
+#include "dumux-precice/solutioncheckpoint.hh"
+#include "dumux-precice/solutionsnapshot.hh"
+#include "dumux-precice/vtkoutputpolicy.hh"
+
 //TODO
 // Helper function to put pressure on interface
 
@@ -86,10 +95,14 @@ auto pressureAtInterface(const Problem &problem,
 template<class FluxVariables,
          class Problem,
          class GridVariables,
-         class SolutionVector>
-void setInterfacePressures(const Problem &problem,
+         class SolutionVector,
+         class CoupledElements>
+void setInterfacePressures(Dumux::Precice::CouplingAdapter &couplingInterface,
+                           const Dumux::Precice::ScalarQuantityHandle pressureId,
+                           const Problem &problem,
                            const GridVariables &gridVars,
-                           const SolutionVector &sol)
+                           const SolutionVector &sol,
+                           const CoupledElements &coupledElements)
 {
     const auto &gridGeometry = problem.gridGeometry();
     auto fvGeometry = localView(gridGeometry);
@@ -97,60 +110,71 @@ void setInterfacePressures(const Problem &problem,
     auto elemFaceVars = localView(gridVars.curGridFaceVars());
     auto elemFluxVarsCache = localView(gridVars.gridFluxVarsCache());
 
-    auto &couplingInterface = Dumux::Precice::CouplingAdapter::getInstance();
-    const auto pressureId = couplingInterface.getIdFromName("Pressure");
+    std::vector<double> values;
+    values.reserve(coupledElements.faceIDs().size());
 
-    for (const auto &element : elements(gridGeometry.gridView())) {
+    for (const auto &coupledElement : coupledElements) {
+        const auto element =
+            coupledElements.element(gridGeometry, coupledElement);
         fvGeometry.bind(element);
         elemVolVars.bind(element, fvGeometry, sol);
         elemFaceVars.bind(element, fvGeometry, sol);
         elemFluxVarsCache.bind(element, fvGeometry, elemVolVars);
 
-        for (const auto &scvf : scvfs(fvGeometry)) {
-            if (couplingInterface.isCoupledEntity(scvf.index())) {
-                //TODO: What to do here?
-                const auto p = pressureAtInterface<FluxVariables>(
-                    problem, element, scvf, fvGeometry, elemVolVars,
-                    elemFaceVars, elemFluxVarsCache);
-                couplingInterface.writeScalarQuantityOnFace(pressureId,
-                                                            scvf.index(), p);
-            }
+        for (const auto scvfIdx : coupledElement.scvfIndices) {
+            const auto &scvf = fvGeometry.scvf(scvfIdx);
+            const auto p = pressureAtInterface<FluxVariables>(
+                problem, element, scvf, fvGeometry, elemVolVars,
+                elemFaceVars, elemFluxVarsCache);
+            values.push_back(p);
         }
     }
+
+    // the values are in the order of the faces passed to createIndexMapping
+    couplingInterface.writeQuantityOnFaces(pressureId, values);
 }
 
-template<class Problem, class GridVariables, class SolutionVector>
-void setInterfaceVelocities(const Problem &problem,
+template<class Problem,
+         class GridVariables,
+         class SolutionVector,
+         class CoupledElements>
+void setInterfaceVelocities(Dumux::Precice::CouplingAdapter &couplingInterface,
+                            const Dumux::Precice::ScalarQuantityHandle velocityId,
+                            const Problem &problem,
                             const GridVariables &gridVars,
-                            const SolutionVector &sol)
+                            const SolutionVector &sol,
+                            const CoupledElements &coupledElements)
 {
     const auto &gridGeometry = problem.gridGeometry();
     auto fvGeometry = localView(gridGeometry);
     auto elemVolVars = localView(gridVars.curGridVolVars());
     auto elemFaceVars = localView(gridVars.curGridFaceVars());
 
-    auto &couplingInterface = Dumux::Precice::CouplingAdapter::getInstance();
-    const auto velocityId = couplingInterface.getIdFromName("Velocity");
+    std::vector<double> values;
+    values.reserve(coupledElements.faceIDs().size());
 
-    for (const auto &element : elements(gridGeometry.gridView())) {
+    for (const auto &coupledElement : coupledElements) {
+        const auto element =
+            coupledElements.element(gridGeometry, coupledElement);
         fvGeometry.bindElement(element);
         elemVolVars.bindElement(element, fvGeometry, sol);
         elemFaceVars.bindElement(element, fvGeometry, sol);
 
-        for (const auto &scvf : scvfs(fvGeometry)) {
-            if (couplingInterface.isCoupledEntity(scvf.index())) {
-                //TODO: What to do here?
-                const auto v = velocityAtInterface(elemFaceVars,
-                                                   scvf)[scvf.directionIndex()];
-                couplingInterface.writeScalarQuantityOnFace(velocityId,
-                                                            scvf.index(), v);
-            }
+        for (const auto scvfIdx : coupledElement.scvfIndices) {
+            const auto &scvf = fvGeometry.scvf(scvfIdx);
+            const auto v = velocityAtInterface(elemFaceVars,
+                                               scvf)[scvf.directionIndex()];
+            values.push_back(v);
         }
     }
+
+    // the values are in the order of the faces passed to createIndexMapping
+    couplingInterface.writeQuantityOnFaces(velocityId, values);
 }
 
 template<class Problem, class GridVariables, class SolutionVector>
 std::tuple<double, double, double> writeVelocitiesOnInterfaceToFile(
+    const Dumux::Precice::CouplingAdapter &couplingInterface,
     const std::string &filename,
     const Problem &problem,
     const GridVariables &gridVars,
@@ -161,9 +185,6 @@ std::tuple<double, double, double> writeVelocitiesOnInterfaceToFile(
     auto elemVolVars = localView(gridVars.curGridVolVars());
     auto elemFaceVars = localView(gridVars.curGridFaceVars());
 
-    const auto &couplingInterface =
-        Dumux::Precice::CouplingAdapter::getInstance();
-
     std::ofstream ofs(filename + ".csv",
                       std::ofstream::out | std::ofstream::trunc);
     ofs << "x,y,";
@@ -209,10 +230,12 @@ template<class FluxVariables,
          class Problem,
          class GridVariables,
          class SolutionVector>
-void writePressuresOnInterfaceToFile(const std::string &filename,
-                                     const Problem &problem,
-                                     const GridVariables &gridVars,
-                                     const SolutionVector &sol)
+void writePressuresOnInterfaceToFile(
+    const Dumux::Precice::CouplingAdapter &couplingInterface,
+    const std::string &filename,
+    const Problem &problem,
+    const GridVariables &gridVars,
+    const SolutionVector &sol)
 {
     const auto &gridGeometry = problem.gridGeometry();
     auto fvGeometry = localView(gridGeometry);
@@ -220,9 +243,6 @@ void writePressuresOnInterfaceToFile(const std::string &filename,
     auto elemFaceVars = localView(gridVars.curGridFaceVars());
     auto elemFluxVarsCache = localView(gridVars.gridFluxVarsCache());
 
-    const auto &couplingInterface =
-        Dumux::Precice::CouplingAdapter::getInstance();
-
     std::ofstream ofs(filename + ".csv",
                       std::ofstream::out | std::ofstream::trunc);
     ofs << "x,y,";
@@ -291,9 +311,12 @@ try {
 #endif
 
     // the problem (initial and boundary conditions)
+    // the coupling adapter, passed to everything that exchanges data
+    Dumux::Precice::CouplingAdapter couplingInterface;
+
     using FreeFlowProblem = GetPropType<FreeFlowTypeTag, Properties::Problem>;
     auto freeFlowProblem =
-        std::make_shared<FreeFlowProblem>(freeFlowGridGeometry);
+        std::make_shared<FreeFlowProblem>(freeFlowGridGeometry, couplingInterface);
 
     // the solution vector
     GetPropType<FreeFlowTypeTag, Properties::SolutionVector> sol;
@@ -313,10 +336,15 @@ try {
     if (argc > 2)
         preciceConfigFilename = argv[argc - 1];
 
-    auto &couplingInterface = Dumux::Precice::CouplingAdapter::getInstance();
     couplingInterface.announceSolver("FreeFlow", preciceConfigFilename,
                                      mpiHelper.rank(), mpiHelper.size());
 
+    // the statistics allow to collect the results of parameter sweeps
+    const auto statisticsFileName =
+        getParamFromGroup<std::string>("preCICE", "StatisticsFileName", "");
+    if (!statisticsFileName.empty())
+        couplingInterface.enableStatisticsSummary(statisticsFileName);
+
     const int dim = couplingInterface.getDimensions();
     std::cout << dim << "  " << int(FreeFlowGridGeometry::GridView::dimension)
               << std::endl;
@@ -328,30 +356,36 @@ try {
         getParamFromGroup<std::vector<double>>("Darcy", "Grid.LowerLeft")[0];
     const double xMax =
         getParamFromGroup<std::vector<double>>("Darcy", "Grid.UpperRight")[0];
-    std::vector<double> coords;  //( dim * vertexSize );
-    std::vector<int> coupledScvfIndices;
-
-    for (const auto &element : elements(freeFlowGridView)) {
-        auto fvGeometry = localView(*freeFlowGridGeometry);
-        fvGeometry.bindElement(element);
-
-        for (const auto &scvf : scvfs(fvGeometry)) {
-            static constexpr auto eps = 1e-7;
-            const auto &pos = scvf.center();
-            if (pos[1] < freeFlowGridGeometry->bBoxMin()[1] + eps) {
-                if (pos[0] > xMin - eps && pos[0] < xMax + eps) {
-                    coupledScvfIndices.push_back(scvf.index());
-                    for (const auto p : pos)
-                        coords.push_back(p);
-                }
-            }
-        }
-    }
-
-    const auto numberOfPoints = coords.size() / dim;
-    const double preciceDt = couplingInterface.setMeshAndInitialize(
-        "FreeFlowMesh", numberOfPoints, coords);
-    couplingInterface.createIndexMapping(coupledScvfIndices);
+    Dumux::Precice::InterfaceVertices<FreeFlowGridGeometry> interfaceVertices;
+    const auto isOnInterface = [&](const auto &scvf) {
+        static constexpr auto eps = 1e-7;
+        const auto &pos = scvf.center();
+        return pos[1] < freeFlowGridGeometry->bBoxMin()[1] + eps &&
+               pos[0] > xMin - eps && pos[0] < xMax + eps;
+    };
+    // The interface only depends on the grid and the extent of the Darcy
+    // domain, which identifies it in the cache file. Both participants read
+    // the same parameters, so the mesh name is appended to the file name.
+    auto interfaceCacheFile =
+        getParamFromGroup<std::string>("preCICE", "InterfaceCacheFile", "");
+    if (!interfaceCacheFile.empty())
+        interfaceCacheFile += ".FreeFlowMesh";
+    std::ostringstream interfaceCacheKey;
+    interfaceCacheKey.precision(std::numeric_limits<double>::max_digits10);
+    interfaceCacheKey << xMin << " " << xMax;
+    interfaceVertices.update(*freeFlowGridGeometry, isOnInterface,
+                             interfaceCacheFile, interfaceCacheKey.str());
+    if (getParamFromGroup<bool>("preCICE", "ReportInterfaceLoad", false))
+        interfaceVertices.reportLoad(freeFlowGridView.comm(), std::cout);
+
+    interfaceVertices.setMesh(couplingInterface, "FreeFlowMesh");
+    const double preciceDt = couplingInterface.initialize();
+
+    Dumux::Precice::CoupledElements<FreeFlowGridGeometry> coupledElements;
+    coupledElements.update(*freeFlowGridGeometry, interfaceVertices);
+    // The interface vertices are only needed to set up the coupling
+    interfaceVertices.release();
+    couplingInterface.releaseSetupData();
 
     const auto velocityId =
         couplingInterface.announceScalarQuantity("Velocity");
@@ -370,14 +404,53 @@ try {
         freeFlowProblem, freeFlowGridGeometry);
     freeFlowGridVariables->init(sol);
 
+    // the output counters, stored in the snapshots with the solution
+    double vtkTime = 1.0;
+    size_t iter = 0;
+
+    // resume from the snapshot of a previous run, see enableSnapshots. Both
+    // participants read the same parameters, so they resume from the same
+    // time window and the mesh name is appended to the file name.
+    auto snapshotFileName =
+        getParamFromGroup<std::string>("preCICE", "SnapshotFileName", "");
+    const auto restartTimeWindow =
+        getParamFromGroup<std::size_t>("preCICE", "RestartTimeWindow", 0);
+    if (!snapshotFileName.empty()) {
+        snapshotFileName += ".FreeFlowMesh";
+        if (mpiHelper.size() > 1)
+            snapshotFileName += "." + std::to_string(mpiHelper.rank());
+        couplingInterface.enableSnapshots(
+            snapshotFileName,
+            getParamFromGroup<std::size_t>("preCICE", "SnapshotInterval", 1));
+        if (restartTimeWindow > 0) {
+            std::vector<double> snapshotState;
+            couplingInterface.readSnapshot(snapshotState, restartTimeWindow);
+            iter = std::size_t(snapshotState.back());
+            snapshotState.pop_back();
+            vtkTime = snapshotState.back();
+            snapshotState.pop_back();
+            Dumux::Precice::restoreSolution(sol, snapshotState);
+            freeFlowGridVariables->init(sol);
+        }
+    }
+    // a resumed run writes its own output instead of overwriting the
+    // output of the previous run
+    const auto vtkName =
+        freeFlowProblem->name() +
+        (restartTimeWindow > 0
+             ? "-restart" + std::to_string(restartTimeWindow)
+             : std::string());
+
     // intialize the vtk output module
     StaggeredVtkOutputModule<FreeFlowGridVariables, decltype(sol)>
-        freeFlowVtkWriter(*freeFlowGridVariables, sol, freeFlowProblem->name());
+        freeFlowVtkWriter(*freeFlowGridVariables, sol, vtkName);
     GetPropType<FreeFlowTypeTag, Properties::IOFields>::initOutputModule(
         freeFlowVtkWriter);
     freeFlowVtkWriter.addField(freeFlowProblem->getAnalyticalVelocityX(),
                                "analyticalV_x");
-    freeFlowVtkWriter.write(0.0);
+    Dumux::Precice::VtkOutputPolicy vtkOutputPolicy;
+    vtkOutputPolicy.setCompletedTimeWindows(restartTimeWindow);
+    freeFlowVtkWriter.write(vtkTime - 1., vtkOutputPolicy.outputType());
 
     using FluxVariables =
         GetPropType<FreeFlowTypeTag, Properties::FluxVariables>;
@@ -386,8 +459,9 @@ try {
         //TODO
         //      couplingInterface.writeQuantityVector( pressureId );
 
-        setInterfacePressures<FluxVariables>(*freeFlowProblem,
-                                             *freeFlowGridVariables, sol);
+        setInterfacePressures<FluxVariables>(
+            couplingInterface, pressureId, *freeFlowProblem,
+            *freeFlowGridVariables, sol, coupledElements);
         //For testing
         //      {
         //        std::cout << "Pressures to be sent to pm" << std::endl;
@@ -408,28 +482,32 @@ try {
         freeFlowProblem, freeFlowGridGeometry, freeFlowGridVariables);
 
     // the linear solver
-    using LinearSolver = UMFPackBackend;
+    using LinearSolver = Dumux::Precice::SelectableLinearSolver;
     auto linearSolver = std::make_shared<LinearSolver>();
 
     // the non-linear solver
-    using NewtonSolver = NewtonSolver<Assembler, LinearSolver>;
+    using NewtonSolver =
+        Dumux::Precice::JacobianReuseNewtonSolver<Assembler, LinearSolver>;
     NewtonSolver nonLinearSolver(assembler, linearSolver);
 
     auto dt = preciceDt;
-    auto sol_checkpoint = sol;
-
-    double vtkTime = 1.0;
-    size_t iter = 0;
+    const auto checkpointMode =
+        getParam<bool>("Problem.KeepIterateOnCheckpointRead", false)
+            ? Dumux::Precice::CheckpointRestoreMode::KeepIterate
+            : Dumux::Precice::CheckpointRestoreMode::Full;
+    Dumux::Precice::SolutionCheckpoint<decltype(sol)> checkpoint(
+        sol, checkpointMode);
 
     while (couplingInterface.isCouplingOngoing()) {
         if (couplingInterface.hasToWriteIterationCheckpoint()) {
             //DO CHECKPOINTING
-            sol_checkpoint = sol;
+            checkpoint.store(sol);
             couplingInterface.announceIterationCheckpointWritten();
         }
 
         // TODO
         couplingInterface.readScalarQuantityFromOtherSolver(velocityId);
+        freeFlowProblem->updateCoupledFaceValues();
         //        // For testing
         //        {
         //          const auto v = couplingInterface.getQuantityVector( velocityId );
@@ -441,8 +519,9 @@ try {
         nonLinearSolver.solve(sol);
 
         // TODO
-        setInterfacePressures<FluxVariables>(*freeFlowProblem,
-                                             *freeFlowGridVariables, sol);
+        setInterfacePressures<FluxVariables>(
+            couplingInterface, pressureId, *freeFlowProblem,
+            *freeFlowGridVariables, sol, coupledElements);
         // For testing
         //        {
         //          const auto p = couplingInterface.getQuantityVector( pressureId );
@@ -456,8 +535,10 @@ try {
         couplingInterface.writeScalarQuantityToOtherSolver(pressureId);
 
         //Read checkpoint
-        freeFlowVtkWriter.write(vtkTime);
-        vtkTime += 1.;
+        if (vtkOutputPolicy.writeIteration()) {
+            freeFlowVtkWriter.write(vtkTime, vtkOutputPolicy.outputType());
+            vtkTime += 1.;
+        }
         const double preciceDt = couplingInterface.advance(dt);
         dt = std::min(preciceDt, dt);
 
@@ -467,15 +548,27 @@ try {
             //            //Read checkpoint
             //            freeFlowVtkWriter.write(vtkTime);
             //            vtkTime += 1.;
-            sol = sol_checkpoint;
-            freeFlowGridVariables->update(sol);
-            freeFlowGridVariables->advanceTimeStep();
+            checkpoint.restore(sol, *freeFlowGridVariables);
             //freeFlowGridVariables->init(sol);
             couplingInterface.announceIterationCheckpointRead();
         } else  // coupling successful
         {
+            // the Jacobian of the next time window differs
+            nonLinearSolver.invalidateJacobian();
+            linearSolver->resetPreconditioner();
+
             // write vtk output
-            freeFlowVtkWriter.write(vtkTime);
+            if (vtkOutputPolicy.writeTimeWindow()) {
+                freeFlowVtkWriter.write(vtkTime, vtkOutputPolicy.outputType());
+                vtkTime += 1.;
+            }
+
+            if (couplingInterface.hasToWriteSnapshot()) {
+                auto snapshotState = Dumux::Precice::flattenSolution(sol);
+                snapshotState.push_back(vtkTime);
+                snapshotState.push_back(double(iter));
+                couplingInterface.writeSnapshot(snapshotState);
+            }
         }
     }
     ////////////////////////////////////////////////////////////
@@ -26,6 +26,8 @@
 #include <ctime>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include <string>
 
 bool printstuff = false;
@@ -42,7 +44,6 @@ bool printstuff = false;
 #include <dumux/common/parameters.hh>
 #include <dumux/common/properties.hh>
 
-#include <dumux/linear/amgbackend.hh>
 #include <dumux/nonlinear/newtonsolver.hh>
 
 #include <dumux/assembly/diffmethod.hh>
@@ -55,6 +56,14 @@ bool printstuff = false;
 
 #include "pmproblem-reversed.hh"
 
+#include "dumux-precice/coupledelements.hh"
+#include "dumux-precice/interfacevertices.hh"
+#include "dumux-precice/jacobianreusenewtonsolver.hh"
+#include "dumux-precice/selectablelinearsolver.hh"
+#include "dumux-precice/solutioncheckpoint.hh"
+#include "dumux-precice/solutionsnapshot.hh"
+#include "dumux-precice/vtkoutputpolicy.hh"
+
 /*!
   * \brief Returns the pressure at the interface using Darcy's law for reconstruction
   */
@@ -102,35 +111,42 @@ auto pressureAtInterface(const Problem &problem,
            ccPressure;
 }
 
-template<class Problem, class GridVariables, class SolutionVector>
-void setInterfacePressures(const Problem &problem,
+template<class Problem,
+         class GridVariables,
+         class SolutionVector,
+         class CoupledElements>
+void setInterfacePressures(Dumux::Precice::CouplingAdapter &couplingInterface,
+                           const Dumux::Precice::ScalarQuantityHandle pressureId,
+                           const Problem &problem,
                            const GridVariables &gridVars,
-                           const SolutionVector &sol)
+                           const SolutionVector &sol,
+                           const CoupledElements &coupledElements)
 {
     const auto &gridGeometry = problem.gridGeometry();
     auto fvGeometry = localView(gridGeometry);
     auto elemVolVars = localView(gridVars.curGridVolVars());
     auto elemFluxVarsCache = localView(gridVars.gridFluxVarsCache());
 
-    auto &couplingInterface = Dumux::Precice::CouplingAdapter::getInstance();
-    const auto pressureId = couplingInterface.getIdFromName("Pressure");
+    std::vector<double> values;
+    values.reserve(coupledElements.faceIDs().size());
 
-    for (const auto &element : elements(gridGeometry.gridView())) {
+    for (const auto &coupledElement : coupledElements) {
+        const auto element =
+            coupledElements.element(gridGeometry, coupledElement);
         fvGeometry.bindElement(element);
         elemVolVars.bindElement(element, fvGeometry, sol);
 
-        //sstd::cout << "Pressure by reconstruction" << std::endl;
-        for (const auto &scvf : scvfs(fvGeometry)) {
-            if (couplingInterface.isCoupledEntity(scvf.index())) {
-                //TODO: What to do here?
-                const double p =
-                    pressureAtInterface(problem, element, gridGeometry,
-                                        elemVolVars, scvf, elemFluxVarsCache);
-                couplingInterface.writeScalarQuantityOnFace(pressureId,
-                                                            scvf.index(), p);
-            }
+        for (const auto scvfIdx : coupledElement.scvfIndices) {
+            const auto &scvf = fvGeometry.scvf(scvfIdx);
+            const double p =
+                pressureAtInterface(problem, element, gridGeometry,
+                                    elemVolVars, scvf, elemFluxVarsCache);
+            values.push_back(p);
         }
     }
+
+    // the values are in the order of the faces passed to createIndexMapping
+    couplingInterface.writeQuantityOnFaces(pressureId, values);
 }
 
 /*!
@@ -165,35 +181,41 @@ auto velocityAtInterface(const Problem &problem,
 template<class FluxVariables,
          class Problem,
          class GridVariables,
-         class SolutionVector>
-void setInterfaceVelocities(const Problem &problem,
+         class SolutionVector,
+         class CoupledElements>
+void setInterfaceVelocities(Dumux::Precice::CouplingAdapter &couplingInterface,
+                            const Dumux::Precice::ScalarQuantityHandle velocityId,
+                            const Problem &problem,
                             const GridVariables &gridVars,
-                            const SolutionVector &sol)
+                            const SolutionVector &sol,
+                            const CoupledElements &coupledElements)
 {
     const auto &gridGeometry = problem.gridGeometry();
     auto fvGeometry = localView(gridGeometry);
     auto elemVolVars = localView(gridVars.curGridVolVars());
     auto elemFluxVarsCache = localView(gridVars.gridFluxVarsCache());
 
-    auto &couplingInterface = Dumux::Precice::CouplingAdapter::getInstance();
-    const auto velocityId = couplingInterface.getIdFromName("Velocity");
+    std::vector<double> values;
+    values.reserve(coupledElements.faceIDs().size());
 
-    for (const auto &element : elements(gridGeometry.gridView())) {
+    for (const auto &coupledElement : coupledElements) {
+        const auto element =
+            coupledElements.element(gridGeometry, coupledElement);
         fvGeometry.bind(element);
         elemVolVars.bind(element, fvGeometry, sol);
         elemFluxVarsCache.bind(element, fvGeometry, elemVolVars);
 
-        for (const auto &scvf : scvfs(fvGeometry)) {
-            if (couplingInterface.isCoupledEntity(scvf.index())) {
-                //TODO: What to do here?
-                const double v = velocityAtInterface<FluxVariables>(
-                    problem, element, fvGeometry, elemVolVars, scvf,
-                    elemFluxVarsCache);
-                couplingInterface.writeScalarQuantityOnFace(velocityId,
-                                                            scvf.index(), v);
-            }
+        for (const auto scvfIdx : coupledElement.scvfIndices) {
+            const auto &scvf = fvGeometry.scvf(scvfIdx);
+            const double v = velocityAtInterface<FluxVariables>(
+                problem, element, fvGeometry, elemVolVars, scvf,
+                elemFluxVarsCache);
+            values.push_back(v);
         }
     }
+
+    // the values are in the order of the faces passed to createIndexMapping
+    couplingInterface.writeQuantityOnFaces(velocityId, values);
 }
 
 template<class FluxVariables,
@@ -201,6 +223,7 @@ template<class FluxVariables,
          class GridVariables,
          class SolutionVector>
 std::tuple<double, double, double> writeVelocitiesOnInterfaceToFile(
+    const Dumux::Precice::CouplingAdapter &couplingInterface,
     const std::string &filename,
     const Problem &problem,
     const GridVariables &gridVars,
@@ -211,9 +234,6 @@ std::tuple<double, double, double> writeVelocitiesOnInterfaceToFile(
     auto elemVolVars = localView(gridVars.curGridVolVars());
     auto elemFluxVarsCache = localView(gridVars.gridFluxVarsCache());
 
-    const auto &couplingInterface =
-        Dumux::Precice::CouplingAdapter::getInstance();
-
     std::ofstream ofs(filename + ".csv",
                       std::ofstream::out | std::ofstream::trunc);
     ofs << "x,y,";
@@ -256,19 +276,18 @@ std::tuple<double, double, double> writeVelocitiesOnInterfaceToFile(
 }
 
 template<class Problem, class GridVariables, class SolutionVector>
-void writePressuresOnInterfaceToFile(const std::string &filename,
-                                     const Problem &problem,
-                                     const GridVariables &gridVars,
-                                     const SolutionVector &sol)
+void writePressuresOnInterfaceToFile(
+    const Dumux::Precice::CouplingAdapter &couplingInterface,
+    const std::string &filename,
+    const Problem &problem,
+    const GridVariables &gridVars,
+    const SolutionVector &sol)
 {
     const auto &gridGeometry = problem.gridGeometry();
     auto fvGeometry = localView(gridGeometry);
     auto elemVolVars = localView(gridVars.curGridVolVars());
     auto elemFluxVarsCache = localView(gridVars.gridFluxVarsCache());
 
-    const auto &couplingInterface =
-        Dumux::Precice::CouplingAdapter::getInstance();
-
     std::ofstream ofs(filename + ".csv",
                       std::ofstream::out | std::ofstream::trunc);
     ofs << "x,y,";
@@ -332,8 +351,12 @@ try {
     darcyGridGeometry->update();
 #endif
 
+    // the coupling adapter, passed to everything that exchanges data
+    Dumux::Precice::CouplingAdapter couplingInterface;
+
     using DarcyProblem = GetPropType<DarcyTypeTag, Properties::Problem>;
-    auto darcyProblem = std::make_shared<DarcyProblem>(darcyGridGeometry);
+    auto darcyProblem =
+        std::make_shared<DarcyProblem>(darcyGridGeometry, couplingInterface);
 
     // the solution vector
     GetPropType<DarcyTypeTag, Properties::SolutionVector> sol;
@@ -350,10 +373,15 @@ try {
     if (argc > 2)
         preciceConfigFilename = argv[argc - 1];
 
-    auto &couplingInterface = Dumux::Precice::CouplingAdapter::getInstance();
     couplingInterface.announceSolver("Darcy", preciceConfigFilename,
                                      mpiHelper.rank(), mpiHelper.size());
 
+    // the statistics allow to collect the results of parameter sweeps
+    const auto statisticsFileName =
+        getParamFromGroup<std::string>("preCICE", "StatisticsFileName", "");
+    if (!statisticsFileName.empty())
+        couplingInterface.enableStatisticsSummary(statisticsFileName);
+
     const int dim = couplingInterface.getDimensions();
     std::cout << dim << "  " << int(DarcyGridGeometry::GridView::dimension)
               << std::endl;
@@ -365,30 +393,36 @@ try {
         getParamFromGroup<std::vector<double>>("Darcy", "Grid.LowerLeft")[0];
     const double xMax =
         getParamFromGroup<std::vector<double>>("Darcy", "Grid.UpperRight")[0];
-    std::vector<double> coords;  //( dim * vertexSize );
-    std::vector<int> coupledScvfIndices;
-
-    for (const auto &element : elements(darcyGridView)) {
-        auto fvGeometry = localView(*darcyGridGeometry);
-        fvGeometry.bindElement(element);
-
-        for (const auto &scvf : scvfs(fvGeometry)) {
-            static constexpr auto eps = 1e-7;
-            const auto &pos = scvf.center();
-            if (pos[1] > darcyGridGeometry->bBoxMax()[1] - eps) {
-                if (pos[0] > xMin - eps && pos[0] < xMax + eps) {
-                    coupledScvfIndices.push_back(scvf.index());
-                    for (const auto p : pos)
-                        coords.push_back(p);
-                }
-            }
-        }
-    }
-
-    const auto numberOfPoints = coords.size() / dim;
-    const double preciceDt = couplingInterface.setMeshAndInitialize(
-        "DarcyMesh", numberOfPoints, coords);
-    couplingInterface.createIndexMapping(coupledScvfIndices);
+    Dumux::Precice::InterfaceVertices<DarcyGridGeometry> interfaceVertices;
+    const auto isOnInterface = [&](const auto &scvf) {
+        static constexpr auto eps = 1e-7;
+        const auto &pos = scvf.center();
+        return pos[1] > darcyGridGeometry->bBoxMax()[1] - eps &&
+               pos[0] > xMin - eps && pos[0] < xMax + eps;
+    };
+    // The interface only depends on the grid and the extent of the Darcy
+    // domain, which identifies it in the cache file. Both participants read
+    // the same parameters, so the mesh name is appended to the file name.
+    auto interfaceCacheFile =
+        getParamFromGroup<std::string>("preCICE", "InterfaceCacheFile", "");
+    if (!interfaceCacheFile.empty())
+        interfaceCacheFile += ".DarcyMesh";
+    std::ostringstream interfaceCacheKey;
+    interfaceCacheKey.precision(std::numeric_limits<double>::max_digits10);
+    interfaceCacheKey << xMin << " " << xMax;
+    interfaceVertices.update(*darcyGridGeometry, isOnInterface,
+                             interfaceCacheFile, interfaceCacheKey.str());
+    if (getParamFromGroup<bool>("preCICE", "ReportInterfaceLoad", false))
+        interfaceVertices.reportLoad(darcyGridView.comm(), std::cout);
+    const auto &coords = interfaceVertices.coordinates();
+
+    interfaceVertices.setMesh(couplingInterface, "DarcyMesh");
+    const double preciceDt = couplingInterface.initialize();
+
+    Dumux::Precice::CoupledElements<DarcyGridGeometry> coupledElements;
+    coupledElements.update(*darcyGridGeometry, interfaceVertices);
+    // The coordinates are kept for the test output below
+    couplingInterface.releaseSetupData();
 
     const auto velocityId =
         couplingInterface.announceScalarQuantity("Velocity");
@@ -406,27 +440,67 @@ try {
         std::make_shared<DarcyGridVariables>(darcyProblem, darcyGridGeometry);
     darcyGridVariables->init(sol);
 
+    // the output counters, stored in the snapshots with the solution
+    double vtkTime = 1.0;
+    size_t iter = 0;
+
+    // resume from the snapshot of a previous run, see enableSnapshots. Both
+    // participants read the same parameters, so they resume from the same
+    // time window and the mesh name is appended to the file name.
+    auto snapshotFileName =
+        getParamFromGroup<std::string>("preCICE", "SnapshotFileName", "");
+    const auto restartTimeWindow =
+        getParamFromGroup<std::size_t>("preCICE", "RestartTimeWindow", 0);
+    if (!snapshotFileName.empty()) {
+        snapshotFileName += ".DarcyMesh";
+        if (mpiHelper.size() > 1)
+            snapshotFileName += "." + std::to_string(mpiHelper.rank());
+        couplingInterface.enableSnapshots(
+            snapshotFileName,
+            getParamFromGroup<std::size_t>("preCICE", "SnapshotInterval", 1));
+        if (restartTimeWindow > 0) {
+            std::vector<double> snapshotState;
+            couplingInterface.readSnapshot(snapshotState, restartTimeWindow);
+            iter = std::size_t(snapshotState.back());
+            snapshotState.pop_back();
+            vtkTime = snapshotState.back();
+            snapshotState.pop_back();
+            Dumux::Precice::restoreSolution(sol, snapshotState);
+            darcyGridVariables->init(sol);
+        }
+    }
+    // a resumed run writes its own output instead of overwriting the
+    // output of the previous run
+    const auto vtkName =
+        darcyProblem->name() +
+        (restartTimeWindow > 0
+             ? "-restart" + std::to_string(restartTimeWindow)
+             : std::string());
+
     // intialize the vtk output module
     const auto darcyName =
         getParam<std::string>("Problem.Name") + "_" + darcyProblem->name();
 
     VtkOutputModule<DarcyGridVariables,
                     GetPropType<DarcyTypeTag, Properties::SolutionVector>>
-        darcyVtkWriter(*darcyGridVariables, sol, darcyProblem->name());
+        darcyVtkWriter(*darcyGridVariables, sol, vtkName);
     using DarcyVelocityOutput =
         GetPropType<DarcyTypeTag, Properties::VelocityOutput>;
     darcyVtkWriter.addVelocityOutput(
         std::make_shared<DarcyVelocityOutput>(*darcyGridVariables));
     GetPropType<DarcyTypeTag, Properties::IOFields>::initOutputModule(
         darcyVtkWriter);
-    darcyVtkWriter.write(0.0);
+    Dumux::Precice::VtkOutputPolicy vtkOutputPolicy;
+    vtkOutputPolicy.setCompletedTimeWindows(restartTimeWindow);
+    darcyVtkWriter.write(vtkTime - 1., vtkOutputPolicy.outputType());
 
     using FluxVariables = GetPropType<DarcyTypeTag, Properties::FluxVariables>;
     if (couplingInterface.hasToWriteInitialData()) {
         //TODO
         //couplingInterface.writeQuantityVector(velocityId);
-        setInterfaceVelocities<FluxVariables>(*darcyProblem,
-                                              *darcyGridVariables, sol);
+        setInterfaceVelocities<FluxVariables>(
+            couplingInterface, velocityId, *darcyProblem, *darcyGridVariables,
+            sol, coupledElements);
         // For testing
         {
             const auto v = couplingInterface.getQuantityVector(velocityId);
@@ -449,28 +523,32 @@ try {
         darcyProblem, darcyGridGeometry, darcyGridVariables);
 
     // the linear solver
-    using LinearSolver = UMFPackBackend;
+    using LinearSolver = Dumux::Precice::SelectableLinearSolver;
     auto linearSolver = std::make_shared<LinearSolver>();
 
     // the non-linear solver
-    using NewtonSolver = Dumux::NewtonSolver<Assembler, LinearSolver>;
+    using NewtonSolver =
+        Dumux::Precice::JacobianReuseNewtonSolver<Assembler, LinearSolver>;
     NewtonSolver nonLinearSolver(assembler, linearSolver);
 
     auto dt = preciceDt;
-    auto sol_checkpoint = sol;
-
-    double vtkTime = 1.0;
-    size_t iter = 0;
+    const auto checkpointMode =
+        getParam<bool>("Problem.KeepIterateOnCheckpointRead", false)
+            ? Dumux::Precice::CheckpointRestoreMode::KeepIterate
+            : Dumux::Precice::CheckpointRestoreMode::Full;
+    Dumux::Precice::SolutionCheckpoint<decltype(sol)> checkpoint(
+        sol, checkpointMode);
 
     while (couplingInterface.isCouplingOngoing()) {
         if (couplingInterface.hasToWriteIterationCheckpoint()) {
             //DO CHECKPOINTING
-            sol_checkpoint = sol;
+            checkpoint.store(sol);
             couplingInterface.announceIterationCheckpointWritten();
         }
 
         // TODO
         couplingInterface.readScalarQuantityFromOtherSolver(pressureId);
+        darcyProblem->updateCoupledFaceValues();
         // For testing
         {
             const auto p = couplingInterface.getQuantityVector(pressureId);
@@ -491,8 +569,9 @@ try {
 
         // solve the non-linear system
         nonLinearSolver.solve(sol);
-        setInterfaceVelocities<FluxVariables>(*darcyProblem,
-                                              *darcyGridVariables, sol);
+        setInterfaceVelocities<FluxVariables>(
+            couplingInterface, velocityId, *darcyProblem, *darcyGridVariables,
+            sol, coupledElements);
         // For testing
         {
             const auto v = couplingInterface.getQuantityVector(velocityId);
@@ -520,21 +599,35 @@ try {
 
         if (couplingInterface.hasToReadIterationCheckpoint()) {
             //Read checkpoint
-            darcyVtkWriter.write(vtkTime);
-            vtkTime += 1.;
-            sol = sol_checkpoint;
-            darcyGridVariables->update(sol);
-            darcyGridVariables->advanceTimeStep();
+            if (vtkOutputPolicy.writeIteration()) {
+                darcyVtkWriter.write(vtkTime, vtkOutputPolicy.outputType());
+                vtkTime += 1.;
+            }
+            checkpoint.restore(sol, *darcyGridVariables);
             //darcyGridVariables->init(sol);
             couplingInterface.announceIterationCheckpointRead();
         } else  // coupling successful
         {
+            // the Jacobian of the next time window differs
+            nonLinearSolver.invalidateJacobian();
+            linearSolver->resetPreconditioner();
+
             // write vtk output
-            darcyVtkWriter.write(vtkTime);
+            if (vtkOutputPolicy.writeTimeWindow()) {
+                darcyVtkWriter.write(vtkTime, vtkOutputPolicy.outputType());
+                vtkTime += 1.;
+            }
+
+            if (couplingInterface.hasToWriteSnapshot()) {
+                auto snapshotState = Dumux::Precice::flattenSolution(sol);
+                snapshotState.push_back(vtkTime);
+                snapshotState.push_back(double(iter));
+                couplingInterface.writeSnapshot(snapshotState);
+            }
         }
     }
     // write vtk output
-    darcyVtkWriter.write(1.0);
+    darcyVtkWriter.write(1.0, vtkOutputPolicy.outputType());
 
     couplingInterface.finalize();
 
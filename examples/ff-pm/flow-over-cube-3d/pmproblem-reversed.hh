@@ -41,6 +41,7 @@
 #include <dumux/material/components/simpleh2o.hh>
 #include <dumux/material/fluidsystems/1pliquid.hh>
 
+#include <dumux-precice/coupledfacevalues.hh>
 #include <dumux-precice/couplingadapter.hh>
 
 namespace Dumux
@@ -119,10 +120,11 @@ class DarcySubProblem : public PorousMediumFlowProblem<TypeTag>
     using GlobalPosition = typename Element::Geometry::GlobalCoordinate;
 
 public:
-    DarcySubProblem(std::shared_ptr<const GridGeometry> fvGridGeometry)
+    DarcySubProblem(std::shared_ptr<const GridGeometry> fvGridGeometry,
+                    Dumux::Precice::CouplingAdapter &couplingInterface)
         : ParentType(fvGridGeometry, "Darcy"),
           eps_(1e-7),
-          couplingInterface_(Dumux::Precice::CouplingAdapter::getInstance()),
+          couplingInterface_(couplingInterface),
           pressureId_(0),
           velocityId_(0),
           dataIdsWereSet_(false)
@@ -164,7 +166,7 @@ public:
         values.setAllNeumann();
 
         const auto faceId = scvf.index();
-        if (couplingInterface_.isCoupledEntity(faceId))
+        if (coupledFaceValues_.isCoupled(faceId))
             values.setAllDirichlet();
         return values;
     }
@@ -185,9 +187,9 @@ public:
         values = initial(element);
 
         const auto faceId = scvf.index();
-        if (couplingInterface_.isCoupledEntity(faceId))
+        if (coupledFaceValues_.isCoupled(faceId))
             values =
-                couplingInterface_.getScalarQuantityOnFace(pressureId_, faceId);
+                coupledFaceValues_.value(pressureId_, faceId);
 
         return values;
     }
@@ -281,6 +283,18 @@ public:
         pressureId_ = couplingInterface_.getIdFromName("Pressure");
         velocityId_ = couplingInterface_.getIdFromName("Velocity");
         dataIdsWereSet_ = true;
+        coupledFaceValues_.setCoupledFaces(couplingInterface_,
+                                           this->gridGeometry().numScvf());
+        updateCoupledFaceValues();
+    }
+
+    /*!
+     * \brief Copies the pressure on the coupling interface from the
+     *        coupling adapter, must be called after every read.
+     */
+    void updateCoupledFaceValues()
+    {
+        coupledFaceValues_.update(couplingInterface_, pressureId_);
     }
 
 private:
@@ -310,6 +324,7 @@ private:
     size_t pressureId_;
     size_t velocityId_;
     bool dataIdsWereSet_;
+    Dumux::Precice::CoupledFaceValues coupledFaceValues_;
 };
 }  // namespace Dumux
 
@@ -25,6 +25,9 @@
 
 #include <ctime>
 #include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
 
 #include <dune/common/parallel/mpihelper.hh>
 #include <dune/common/timer.hh>
@@ -40,14 +43,20 @@
 #include <dumux/io/grid/gridmanager.hh>
 #include <dumux/io/staggeredvtkoutputmodule.hh>
 #include <dumux/io/vtkoutputmodule.hh>
-#include <dumux/linear/seqsolverbackend.hh>
 
 #include <dumux/assembly/staggeredfvassembler.hh>
 #include <dumux/nonlinear/newtonsolver.hh>
 
 #include "ffproblem-reversed.hh"
 
+#include "dumux-precice/coupledelements.hh"
 #include "dumux-precice/couplingadapter.hh"
+#include "dumux-precice/interfacevertices.hh"
+#include "dumux-precice/jacobianreusenewtonsolver.hh"
+#include "dumux-precice/selectablelinearsolver.hh"
+#include "dumux-precice/solutioncheckpoint.hh"
+#include "dumux-precice/solutionsnapshot.hh"
+#include "dumux-precice/vtkoutputpolicy.hh"
 
 //TODO
 // Helper function to put pressure on interface
@@ -88,10 +97,14 @@ auto pressureAtInterface(const Problem &problem,
 template<class FluxVariables,
          class Problem,
          class GridVariables,
-         class SolutionVector>
-void setInterfacePressures(const Problem &problem,
+         class SolutionVector,
+         class CoupledElements>
+void setInterfacePressures(Dumux::Precice::CouplingAdapter &couplingInterface,
+                           const Dumux::Precice::ScalarQuantityHandle pressureId,
+                           const Problem &problem,
                            const GridVariables &gridVars,
-                           const SolutionVector &sol)
+                           const SolutionVector &sol,
+                           const CoupledElements &coupledElements)
 {
     const auto &gridGeometry = problem.gridGeometry();
     auto fvGeometry = localView(gridGeometry);
@@ -99,56 +112,66 @@ void setInterfacePressures(const Problem &problem,
     auto elemFaceVars = localView(gridVars.curGridFaceVars());
     auto elemFluxVarsCache = localView(gridVars.gridFluxVarsCache());
 
-    auto &couplingInterface = Dumux::Precice::CouplingAdapter::getInstance();
-    const auto pressureId = couplingInterface.getIdFromName("Pressure");
+    std::vector<double> values;
+    values.reserve(coupledElements.faceIDs().size());
 
-    for (const auto &element : elements(gridGeometry.gridView())) {
+    for (const auto &coupledElement : coupledElements) {
+        const auto element =
+            coupledElements.element(gridGeometry, coupledElement);
         fvGeometry.bind(element);
         elemVolVars.bind(element, fvGeometry, sol);
         elemFaceVars.bind(element, fvGeometry, sol);
         elemFluxVarsCache.bind(element, fvGeometry, elemVolVars);
 
-        for (const auto &scvf : scvfs(fvGeometry)) {
-            if (couplingInterface.isCoupledEntity(scvf.index())) {
-                //TODO: What to do here?
-                const auto p = pressureAtInterface<FluxVariables>(
-                    problem, element, scvf, fvGeometry, elemVolVars,
-                    elemFaceVars, elemFluxVarsCache);
-                couplingInterface.writeScalarQuantityOnFace(pressureId,
-                                                            scvf.index(), p);
-            }
+        for (const auto scvfIdx : coupledElement.scvfIndices) {
+            const auto &scvf = fvGeometry.scvf(scvfIdx);
+            const auto p = pressureAtInterface<FluxVariables>(
+                problem, element, scvf, fvGeometry, elemVolVars,
+                elemFaceVars, elemFluxVarsCache);
+            values.push_back(p);
         }
     }
+
+    // the values are in the order of the faces passed to createIndexMapping
+    couplingInterface.writeQuantityOnFaces(pressureId, values);
 }
 
-template<class Problem, class GridVariables, class SolutionVector>
-void setInterfaceVelocities(const Problem &problem,
+template<class Problem,
+         class GridVariables,
+         class SolutionVector,
+         class CoupledElements>
+void setInterfaceVelocities(Dumux::Precice::CouplingAdapter &couplingInterface,
+                            const Dumux::Precice::ScalarQuantityHandle velocityId,
+                            const Problem &problem,
                             const GridVariables &gridVars,
-                            const SolutionVector &sol)
+                            const SolutionVector &sol,
+                            const CoupledElements &coupledElements)
 {
     const auto &gridGeometry = problem.gridGeometry();
     auto fvGeometry = localView(gridGeometry);
     auto elemVolVars = localView(gridVars.curGridVolVars());
     auto elemFaceVars = localView(gridVars.curGridFaceVars());
 
-    auto &couplingInterface = Dumux::Precice::CouplingAdapter::getInstance();
-    const auto velocityId = couplingInterface.getIdFromName("Velocity");
+    std::vector<double> values;
+    values.reserve(coupledElements.faceIDs().size());
 
-    for (const auto &element : elements(gridGeometry.gridView())) {
+    for (const auto &coupledElement : coupledElements) {
+        const auto element =
+            coupledElements.element(gridGeometry, coupledElement);
         fvGeometry.bindElement(element);
         elemVolVars.bindElement(element, fvGeometry, sol);
         elemFaceVars.bindElement(element, fvGeometry, sol);
 
-        for (const auto &scvf : scvfs(fvGeometry)) {
-            if (couplingInterface.isCoupledEntity(scvf.index())) {
-                //TODO: What to do here?
-                const auto v = velocityAtInterface(elemFaceVars,
-                                                   scvf)[scvf.directionIndex()];
-                couplingInterface.writeScalarQuantityOnFace(velocityId,
-                                                            scvf.index(), v);
-            }
+        for (const auto scvfIdx : coupledElement.scvfIndices) {
+            const auto &scvf = fvGeometry.scvf(scvfIdx);
+            const auto v = velocityAtInterface(elemFaceVars,
+                                               scvf)[scvf.directionIndex()];
+            values.push_back(v);
         }
     }
+
+    // the values are in the order of the faces passed to createIndexMapping
+    couplingInterface.writeQuantityOnFaces(velocityId, values);
 }
 
 int main(int argc, char **argv)
@@ -189,9 +212,12 @@ try {
 #endif
 
     // the problem (initial and boundary conditions)
+    // the coupling adapter, passed to everything that exchanges data
+    Dumux::Precice::CouplingAdapter couplingInterface;
+
     using FreeFlowProblem = GetPropType<FreeFlowTypeTag, Properties::Problem>;
     auto freeFlowProblem =
-        std::make_shared<FreeFlowProblem>(freeFlowGridGeometry);
+        std::make_shared<FreeFlowProblem>(freeFlowGridGeometry, couplingInterface);
 
     // the solution vector
     GetPropType<FreeFlowTypeTag, Properties::SolutionVector> sol;
@@ -211,10 +237,15 @@ try {
     if (argc > 2)
         preciceConfigFilename = argv[argc - 1];
 
-    auto &couplingInterface = Dumux::Precice::CouplingAdapter::getInstance();
     couplingInterface.announceSolver("FreeFlow", preciceConfigFilename,
                                      mpiHelper.rank(), mpiHelper.size());
 
+    // the statistics allow to collect the results of parameter sweeps
+    const auto statisticsFileName =
+        getParamFromGroup<std::string>("preCICE", "StatisticsFileName", "");
+    if (!statisticsFileName.empty())
+        couplingInterface.enableStatisticsSummary(statisticsFileName);
+
     const int dim = couplingInterface.getDimensions();
     std::cout << dim << "  " << int(FreeFlowGridGeometry::GridView::dimension)
               << std::endl;
@@ -226,30 +257,36 @@ try {
         getParamFromGroup<std::vector<double>>("Darcy", "Grid.LowerLeft")[0];
     const double xMax =
         getParamFromGroup<std::vector<double>>("Darcy", "Grid.UpperRight")[0];
-    std::vector<double> coords;  //( dim * vertexSize );
-    std::vector<int> coupledScvfIndices;
-
-    for (const auto &element : elements(freeFlowGridView)) {
-        auto fvGeometry = localView(*freeFlowGridGeometry);
-        fvGeometry.bindElement(element);
-
-        for (const auto &scvf : scvfs(fvGeometry)) {
-            static constexpr auto eps = 1e-7;
-            const auto &pos = scvf.center();
-            if (pos[1] < freeFlowGridGeometry->bBoxMin()[1] + eps) {
-                if (pos[0] > xMin - eps && pos[0] < xMax + eps) {
-                    coupledScvfIndices.push_back(scvf.index());
-                    for (const auto p : pos)
-                        coords.push_back(p);
-                }
-            }
-        }
-    }
-
-    const auto numberOfPoints = coords.size() / dim;
-    const double preciceDt = couplingInterface.setMeshAndInitialize(
-        "FreeFlowMesh", numberOfPoints, coords);
-    couplingInterface.createIndexMapping(coupledScvfIndices);
+    Dumux::Precice::InterfaceVertices<FreeFlowGridGeometry> interfaceVertices;
+    const auto isOnInterface = [&](const auto &scvf) {
+        static constexpr auto eps = 1e-7;
+        const auto &pos = scvf.center();
+        return pos[1] < freeFlowGridGeometry->bBoxMin()[1] + eps &&
+               pos[0] > xMin - eps && pos[0] < xMax + eps;
+    };
+    // The interface only depends on the grid and the extent of the Darcy
+    // domain, which identifies it in the cache file. Both participants read
+    // the same parameters, so the mesh name is appended to the file name.
+    auto interfaceCacheFile =
+        getParamFromGroup<std::string>("preCICE", "InterfaceCacheFile", "");
+    if (!interfaceCacheFile.empty())
+        interfaceCacheFile += ".FreeFlowMesh";
+    std::ostringstream interfaceCacheKey;
+    interfaceCacheKey.precision(std::numeric_limits<double>::max_digits10);
+    interfaceCacheKey << xMin << " " << xMax;
+    interfaceVertices.update(*freeFlowGridGeometry, isOnInterface,
+                             interfaceCacheFile, interfaceCacheKey.str());
+    if (getParamFromGroup<bool>("preCICE", "ReportInterfaceLoad", false))
+        interfaceVertices.reportLoad(freeFlowGridView.comm(), std::cout);
+
+    interfaceVertices.setMesh(couplingInterface, "FreeFlowMesh");
+    const double preciceDt = couplingInterface.initialize();
+
+    Dumux::Precice::CoupledElements<FreeFlowGridGeometry> coupledElements;
+    coupledElements.update(*freeFlowGridGeometry, interfaceVertices);
+    // The interface vertices are only needed to set up the coupling
+    interfaceVertices.release();
+    couplingInterface.releaseSetupData();
 
     const auto velocityId =
         couplingInterface.announceScalarQuantity("Velocity");
@@ -268,21 +305,61 @@ try {
         freeFlowProblem, freeFlowGridGeometry);
     freeFlowGridVariables->init(sol);
 
+    // the output counters, stored in the snapshots with the solution
+    double vtkTime = 1.0;
+    size_t iter = 0;
+
+    // resume from the snapshot of a previous run, see enableSnapshots. Both
+    // participants read the same parameters, so they resume from the same
+    // time window and the mesh name is appended to the file name.
+    auto snapshotFileName =
+        getParamFromGroup<std::string>("preCICE", "SnapshotFileName", "");
+    const auto restartTimeWindow =
+        getParamFromGroup<std::size_t>("preCICE", "RestartTimeWindow", 0);
+    if (!snapshotFileName.empty()) {
+        snapshotFileName += ".FreeFlowMesh";
+        if (mpiHelper.size() > 1)
+            snapshotFileName += "." + std::to_string(mpiHelper.rank());
+        couplingInterface.enableSnapshots(
+            snapshotFileName,
+            getParamFromGroup<std::size_t>("preCICE", "SnapshotInterval", 1));
+        if (restartTimeWindow > 0) {
+            std::vector<double> snapshotState;
+            couplingInterface.readSnapshot(snapshotState, restartTimeWindow);
+            iter = std::size_t(snapshotState.back());
+            snapshotState.pop_back();
+            vtkTime = snapshotState.back();
+            snapshotState.pop_back();
+            Dumux::Precice::restoreSolution(sol, snapshotState);
+            freeFlowGridVariables->init(sol);
+        }
+    }
+    // a resumed run writes its own output instead of overwriting the
+    // output of the previous run
+    const auto vtkName =
+        freeFlowProblem->name() +
+        (restartTimeWindow > 0
+             ? "-restart" + std::to_string(restartTimeWindow)
+             : std::string());
+
     // intialize the vtk output module
     StaggeredVtkOutputModule<FreeFlowGridVariables, decltype(sol)>
-        freeFlowVtkWriter(*freeFlowGridVariables, sol, freeFlowProblem->name());
+        freeFlowVtkWriter(*freeFlowGridVariables, sol, vtkName);
     GetPropType<FreeFlowTypeTag, Properties::IOFields>::initOutputModule(
         freeFlowVtkWriter);
     freeFlowVtkWriter.addField(freeFlowProblem->getAnalyticalVelocityX(),
                                "analyticalV_x");
-    freeFlowVtkWriter.write(0.0);
+    Dumux::Precice::VtkOutputPolicy vtkOutputPolicy;
+    vtkOutputPolicy.setCompletedTimeWindows(restartTimeWindow);
+    freeFlowVtkWriter.write(vtkTime - 1., vtkOutputPolicy.outputType());
 
     using FluxVariables =
         GetPropType<FreeFlowTypeTag, Properties::FluxVariables>;
 
     if (couplingInterface.hasToWriteInitialData()) {
-        setInterfacePressures<FluxVariables>(*freeFlowProblem,
-                                             *freeFlowGridVariables, sol);
+        setInterfacePressures<FluxVariables>(
+            couplingInterface, pressureId, *freeFlowProblem,
+            *freeFlowGridVariables, sol, coupledElements);
         couplingInterface.writeScalarQuantityToOtherSolver(pressureId);
         couplingInterface.announceInitialDataWritten();
     }
@@ -295,39 +372,89 @@ try {
         freeFlowProblem, freeFlowGridGeometry, freeFlowGridVariables);
 
     // the linear solver
-    using LinearSolver = UMFPackBackend;
+    using LinearSolver = Dumux::Precice::SelectableLinearSolver;
     auto linearSolver = std::make_shared<LinearSolver>();
 
     // the non-linear solver
-    using NewtonSolver = NewtonSolver<Assembler, LinearSolver>;
+    using NewtonSolver =
+        Dumux::Precice::JacobianReuseNewtonSolver<Assembler, LinearSolver>;
     NewtonSolver nonLinearSolver(assembler, linearSolver);
 
     auto dt = preciceDt;
-    auto sol_checkpoint = sol;
-
-    double vtkTime = 1.0;
-    size_t iter = 0;
+    const auto checkpointMode =
+        getParam<bool>("Problem.KeepIterateOnCheckpointRead", false)
+            ? Dumux::Precice::CheckpointRestoreMode::KeepIterate
+            : Dumux::Precice::CheckpointRestoreMode::Full;
+    Dumux::Precice::SolutionCheckpoint<decltype(sol)> checkpoint(
+        sol, checkpointMode);
+
+    // skip the solve if the interface data changed less than this tolerance
+    // since the last solve
+    const double interfaceChangeTolerance =
+        getParam<double>("Problem.InterfaceChangeTolerance", 0.0);
+    // interface data of the last solve, only kept if solves may be skipped
+    std::vector<double> solvedVelocities;
+    // true if sol solves the problem for the interface data of the last solve
+    bool solutionIsCurrent = false;
+
+    // loosen the Newton tolerance while the interface residual is large,
+    // early coupling iterations are based on data replaced anyway
+    const double inexactToleranceFactor =
+        getParam<double>("Problem.InexactNewtonToleranceFactor", 0.0);
+    const double newtonTolerance =
+        getParam<double>("Newton.MaxRelativeShift", 1e-8);
+    const double maxNewtonTolerance =
+        getParam<double>("Problem.InexactNewtonMaxTolerance", 1e-2);
+    const auto residualLogFileName =
+        getParamFromGroup<std::string>("preCICE", "ResidualLogFileName", "");
+    // both need the interface residual
+    if (inexactToleranceFactor > 0. || !residualLogFileName.empty())
+        couplingInterface.enableChangeTracking(velocityId);
+    if (!residualLogFileName.empty())
+        couplingInterface.enableResidualLog(residualLogFileName);
+
+    // overlap the exchange with the vtk output, see setAsynchronousAdvance
+    couplingInterface.setAsynchronousAdvance(
+        getParam<bool>("Problem.AsynchronousAdvance", false));
 
     while (couplingInterface.isCouplingOngoing()) {
         if (couplingInterface.hasToWriteIterationCheckpoint()) {
             //DO CHECKPOINTING
-            sol_checkpoint = sol;
+            checkpoint.store(sol);
             couplingInterface.announceIterationCheckpointWritten();
         }
 
         couplingInterface.readScalarQuantityFromOtherSolver(velocityId);
+        freeFlowProblem->updateCoupledFaceValues();
         // solve the non-linear system
-        nonLinearSolver.solve(sol);
+        if (inexactToleranceFactor > 0.)
+            nonLinearSolver.setMaxRelativeShift(
+                couplingInterface.getInexactSolverTolerance(
+                    newtonTolerance, maxNewtonTolerance,
+                    inexactToleranceFactor));
+        if (!solutionIsCurrent || interfaceChangeTolerance <= 0. ||
+            couplingInterface.getRelativeQuantityChange(
+                velocityId, solvedVelocities) >= interfaceChangeTolerance) {
+            nonLinearSolver.solve(sol);
+            if (interfaceChangeTolerance > 0.)
+                solvedVelocities =
+                    couplingInterface.getQuantityVector(velocityId);
+        }
+        solutionIsCurrent = true;
 
         // TODO
-        setInterfacePressures<FluxVariables>(*freeFlowProblem,
-                                             *freeFlowGridVariables, sol);
+        setInterfacePressures<FluxVariables>(
+            couplingInterface, pressureId, *freeFlowProblem,
+            *freeFlowGridVariables, sol, coupledElements);
         couplingInterface.writeScalarQuantityToOtherSolver(pressureId);
 
-        //Read checkpoint
-        freeFlowVtkWriter.write(vtkTime);
-        vtkTime += 1.;
-        const double preciceDt = couplingInterface.advance(dt);
+        // the output does not depend on the exchange and may overlap with it
+        couplingInterface.startAdvance(dt);
+        if (vtkOutputPolicy.writeIteration()) {
+            freeFlowVtkWriter.write(vtkTime, vtkOutputPolicy.outputType());
+            vtkTime += 1.;
+        }
+        const double preciceDt = couplingInterface.finishAdvance();
         dt = std::min(preciceDt, dt);
 
         ++iter;
@@ -336,15 +463,30 @@ try {
             //            //Read checkpoint
             //            freeFlowVtkWriter.write(vtkTime);
             //            vtkTime += 1.;
-            sol = sol_checkpoint;
-            freeFlowGridVariables->update(sol);
-            freeFlowGridVariables->advanceTimeStep();
+            checkpoint.restore(sol, *freeFlowGridVariables);
+            solutionIsCurrent =
+                checkpoint.mode() ==
+                Dumux::Precice::CheckpointRestoreMode::KeepIterate;
             //freeFlowGridVariables->init(sol);
             couplingInterface.announceIterationCheckpointRead();
         } else  // coupling successful
         {
+            // the Jacobian of the next time window differs
+            nonLinearSolver.invalidateJacobian();
+            linearSolver->resetPreconditioner();
+
             // write vtk output
-            freeFlowVtkWriter.write(vtkTime);
+            if (vtkOutputPolicy.writeTimeWindow()) {
+                freeFlowVtkWriter.write(vtkTime, vtkOutputPolicy.outputType());
+                vtkTime += 1.;
+            }
+
+            if (couplingInterface.hasToWriteSnapshot()) {
+                auto snapshotState = Dumux::Precice::flattenSolution(sol);
+                snapshotState.push_back(vtkTime);
+                snapshotState.push_back(double(iter));
+                couplingInterface.writeSnapshot(snapshotState);
+            }
         }
     }
     ////////////////////////////////////////////////////////////
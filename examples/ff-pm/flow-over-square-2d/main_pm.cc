@@ -26,7 +26,10 @@
 #include <ctime>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include <string>
+#include <vector>
 
 bool printstuff = false;
 
@@ -42,7 +45,6 @@ bool printstuff = false;
 #include <dumux/common/parameters.hh>
 #include <dumux/common/properties.hh>
 
-#include <dumux/linear/amgbackend.hh>
 #include <dumux/nonlinear/newtonsolver.hh>
 
 #include <dumux/assembly/diffmethod.hh>
@@ -55,7 +57,14 @@ bool printstuff = false;
 
 #include "pmproblem-reversed.hh"
 
+#include "dumux-precice/coupledelements.hh"
 #include "dumux-precice/couplingadapter.hh"
+#include "dumux-precice/interfacevertices.hh"
+#include "dumux-precice/jacobianreusenewtonsolver.hh"
+#include "dumux-precice/selectablelinearsolver.hh"
+#include "dumux-precice/solutioncheckpoint.hh"
+#include "dumux-precice/solutionsnapshot.hh"
+#include "dumux-precice/vtkoutputpolicy.hh"
 
 /*!
   * \brief Returns the pressure at the interface using Darcy's law for reconstruction
@@ -104,35 +113,42 @@ auto pressureAtInterface(const Problem &problem,
            ccPressure;
 }
 
-template<class Problem, class GridVariables, class SolutionVector>
-void setInterfacePressures(const Problem &problem,
+template<class Problem,
+         class GridVariables,
+         class SolutionVector,
+         class CoupledElements>
+void setInterfacePressures(Dumux::Precice::CouplingAdapter &couplingInterface,
+                           const Dumux::Precice::ScalarQuantityHandle pressureId,
+                           const Problem &problem,
                            const GridVariables &gridVars,
-                           const SolutionVector &sol)
+                           const SolutionVector &sol,
+                           const CoupledElements &coupledElements)
 {
     const auto &gridGeometry = problem.gridGeometry();
     auto fvGeometry = localView(gridGeometry);
     auto elemVolVars = localView(gridVars.curGridVolVars());
     auto elemFluxVarsCache = localView(gridVars.gridFluxVarsCache());
 
-    auto &couplingInterface = Dumux::Precice::CouplingAdapter::getInstance();
-    const auto pressureId = couplingInterface.getIdFromName("Pressure");
+    std::vector<double> values;
+    values.reserve(coupledElements.faceIDs().size());
 
-    for (const auto &element : elements(gridGeometry.gridView())) {
+    for (const auto &coupledElement : coupledElements) {
+        const auto element =
+            coupledElements.element(gridGeometry, coupledElement);
         fvGeometry.bindElement(element);
         elemVolVars.bindElement(element, fvGeometry, sol);
 
-        //sstd::cout << "Pressure by reconstruction" << std::endl;
-        for (const auto &scvf : scvfs(fvGeometry)) {
-            if (couplingInterface.isCoupledEntity(scvf.index())) {
-                //TODO: What to do here?
-                const double p =
-                    pressureAtInterface(problem, element, gridGeometry,
-                                        elemVolVars, scvf, elemFluxVarsCache);
-                couplingInterface.writeScalarQuantityOnFace(pressureId,
-                                                            scvf.index(), p);
-            }
+        for (const auto scvfIdx : coupledElement.scvfIndices) {
+            const auto &scvf = fvGeometry.scvf(scvfIdx);
+            const double p =
+                pressureAtInterface(problem, element, gridGeometry,
+                                    elemVolVars, scvf, elemFluxVarsCache);
+            values.push_back(p);
         }
     }
+
+    // the values are in the order of the faces passed to createIndexMapping
+    couplingInterface.writeQuantityOnFaces(pressureId, values);
 }
 
 /*!
@@ -167,35 +183,41 @@ auto velocityAtInterface(const Problem &problem,
 template<class FluxVariables,
          class Problem,
          class GridVariables,
-         class SolutionVector>
-void setInterfaceVelocities(const Problem &problem,
+         class SolutionVector,
+         class CoupledElements>
+void setInterfaceVelocities(Dumux::Precice::CouplingAdapter &couplingInterface,
+                            const Dumux::Precice::ScalarQuantityHandle velocityId,
+                            const Problem &problem,
                             const GridVariables &gridVars,
-                            const SolutionVector &sol)
+                            const SolutionVector &sol,
+                            const CoupledElements &coupledElements)
 {
     const auto &gridGeometry = problem.gridGeometry();
     auto fvGeometry = localView(gridGeometry);
     auto elemVolVars = localView(gridVars.curGridVolVars());
     auto elemFluxVarsCache = localView(gridVars.gridFluxVarsCache());
 
-    auto &couplingInterface = Dumux::Precice::CouplingAdapter::getInstance();
-    const auto velocityId = couplingInterface.getIdFromName("Velocity");
+    std::vector<double> values;
+    values.reserve(coupledElements.faceIDs().size());
 
-    for (const auto &element : elements(gridGeometry.gridView())) {
+    for (const auto &coupledElement : coupledElements) {
+        const auto element =
+            coupledElements.element(gridGeometry, coupledElement);
         fvGeometry.bind(element);
         elemVolVars.bind(element, fvGeometry, sol);
         elemFluxVarsCache.bind(element, fvGeometry, elemVolVars);
 
-        for (const auto &scvf : scvfs(fvGeometry)) {
-            if (couplingInterface.isCoupledEntity(scvf.index())) {
-                //TODO: What to do here?
-                const double v = velocityAtInterface<FluxVariables>(
-                    problem, element, fvGeometry, elemVolVars, scvf,
-                    elemFluxVarsCache);
-                couplingInterface.writeScalarQuantityOnFace(velocityId,
-                                                            scvf.index(), v);
-            }
+        for (const auto scvfIdx : coupledElement.scvfIndices) {
+            const auto &scvf = fvGeometry.scvf(scvfIdx);
+            const double v = velocityAtInterface<FluxVariables>(
+                problem, element, fvGeometry, elemVolVars, scvf,
+                elemFluxVarsCache);
+            values.push_back(v);
         }
     }
+
+    // the values are in the order of the faces passed to createIndexMapping
+    couplingInterface.writeQuantityOnFaces(velocityId, values);
 }
 
 int main(int argc, char **argv)
@@ -232,8 +254,12 @@ try {
     darcyGridGeometry->update();
 #endif
 
+    // the coupling adapter, passed to everything that exchanges data
+    Dumux::Precice::CouplingAdapter couplingInterface;
+
     using DarcyProblem = GetPropType<DarcyTypeTag, Properties::Problem>;
-    auto darcyProblem = std::make_shared<DarcyProblem>(darcyGridGeometry);
+    auto darcyProblem =
+        std::make_shared<DarcyProblem>(darcyGridGeometry, couplingInterface);
 
     // the solution vector
     GetPropType<DarcyTypeTag, Properties::SolutionVector> sol;
@@ -250,10 +276,15 @@ try {
     if (argc > 2)
         preciceConfigFilename = argv[argc - 1];
 
-    auto &couplingInterface = Dumux::Precice::CouplingAdapter::getInstance();
     couplingInterface.announceSolver("Darcy", preciceConfigFilename,
                                      mpiHelper.rank(), mpiHelper.size());
 
+    // the statistics allow to collect the results of parameter sweeps
+    const auto statisticsFileName =
+        getParamFromGroup<std::string>("preCICE", "StatisticsFileName", "");
+    if (!statisticsFileName.empty())
+        couplingInterface.enableStatisticsSummary(statisticsFileName);
+
     const int dim = couplingInterface.getDimensions();
     std::cout << dim << "  " << int(DarcyGridGeometry::GridView::dimension)
               << std::endl;
@@ -265,30 +296,36 @@ try {
         getParamFromGroup<std::vector<double>>("Darcy", "Grid.LowerLeft")[0];
     const double xMax =
         getParamFromGroup<std::vector<double>>("Darcy", "Grid.UpperRight")[0];
-    std::vector<double> coords;  //( dim * vertexSize );
-    std::vector<int> coupledScvfIndices;
-
-    for (const auto &element : elements(darcyGridView)) {
-        auto fvGeometry = localView(*darcyGridGeometry);
-        fvGeometry.bindElement(element);
-
-        for (const auto &scvf : scvfs(fvGeometry)) {
-            static constexpr auto eps = 1e-7;
-            const auto &pos = scvf.center();
-            if (pos[1] > darcyGridGeometry->bBoxMax()[1] - eps) {
-                if (pos[0] > xMin - eps && pos[0] < xMax + eps) {
-                    coupledScvfIndices.push_back(scvf.index());
-                    for (const auto p : pos)
-                        coords.push_back(p);
-                }
-            }
-        }
-    }
-
-    const auto numberOfPoints = coords.size() / dim;
-    const double preciceDt = couplingInterface.setMeshAndInitialize(
-        "DarcyMesh", numberOfPoints, coords);
-    couplingInterface.createIndexMapping(coupledScvfIndices);
+    Dumux::Precice::InterfaceVertices<DarcyGridGeometry> interfaceVertices;
+    const auto isOnInterface = [&](const auto &scvf) {
+        static constexpr auto eps = 1e-7;
+        const auto &pos = scvf.center();
+        return pos[1] > darcyGridGeometry->bBoxMax()[1] - eps &&
+               pos[0] > xMin - eps && pos[0] < xMax + eps;
+    };
+    // The interface only depends on the grid and the extent of the Darcy
+    // domain, which identifies it in the cache file. Both participants read
+    // the same parameters, so the mesh name is appended to the file name.
+    auto interfaceCacheFile =
+        getParamFromGroup<std::string>("preCICE", "InterfaceCacheFile", "");
+    if (!interfaceCacheFile.empty())
+        interfaceCacheFile += ".DarcyMesh";
+    std::ostringstream interfaceCacheKey;
+    interfaceCacheKey.precision(std::numeric_limits<double>::max_digits10);
+    interfaceCacheKey << xMin << " " << xMax;
+    interfaceVertices.update(*darcyGridGeometry, isOnInterface,
+                             interfaceCacheFile, interfaceCacheKey.str());
+    if (getParamFromGroup<bool>("preCICE", "ReportInterfaceLoad", false))
+        interfaceVertices.reportLoad(darcyGridView.comm(), std::cout);
+
+    interfaceVertices.setMesh(couplingInterface, "DarcyMesh");
+    const double preciceDt = couplingInterface.initialize();
+
+    Dumux::Precice::CoupledElements<DarcyGridGeometry> coupledElements;
+    coupledElements.update(*darcyGridGeometry, interfaceVertices);
+    // The interface vertices are only needed to set up the coupling
+    interfaceVertices.release();
+    couplingInterface.releaseSetupData();
 
     const auto velocityId =
         couplingInterface.announceScalarQuantity("Velocity");
@@ -306,26 +343,66 @@ try {
         std::make_shared<DarcyGridVariables>(darcyProblem, darcyGridGeometry);
     darcyGridVariables->init(sol);
 
+    // the output counters, stored in the snapshots with the solution
+    double vtkTime = 1.0;
+    size_t iter = 0;
+
+    // resume from the snapshot of a previous run, see enableSnapshots. Both
+    // participants read the same parameters, so they resume from the same
+    // time window and the mesh name is appended to the file name.
+    auto snapshotFileName =
+        getParamFromGroup<std::string>("preCICE", "SnapshotFileName", "");
+    const auto restartTimeWindow =
+        getParamFromGroup<std::size_t>("preCICE", "RestartTimeWindow", 0);
+    if (!snapshotFileName.empty()) {
+        snapshotFileName += ".DarcyMesh";
+        if (mpiHelper.size() > 1)
+            snapshotFileName += "." + std::to_string(mpiHelper.rank());
+        couplingInterface.enableSnapshots(
+            snapshotFileName,
+            getParamFromGroup<std::size_t>("preCICE", "SnapshotInterval", 1));
+        if (restartTimeWindow > 0) {
+            std::vector<double> snapshotState;
+            couplingInterface.readSnapshot(snapshotState, restartTimeWindow);
+            iter = std::size_t(snapshotState.back());
+            snapshotState.pop_back();
+            vtkTime = snapshotState.back();
+            snapshotState.pop_back();
+            Dumux::Precice::restoreSolution(sol, snapshotState);
+            darcyGridVariables->init(sol);
+        }
+    }
+    // a resumed run writes its own output instead of overwriting the
+    // output of the previous run
+    const auto vtkName =
+        darcyProblem->name() +
+        (restartTimeWindow > 0
+             ? "-restart" + std::to_string(restartTimeWindow)
+             : std::string());
+
     // intialize the vtk output module
     const auto darcyName =
         getParam<std::string>("Problem.Name") + "_" + darcyProblem->name();
 
     VtkOutputModule<DarcyGridVariables,
                     GetPropType<DarcyTypeTag, Properties::SolutionVector>>
-        darcyVtkWriter(*darcyGridVariables, sol, darcyProblem->name());
+        darcyVtkWriter(*darcyGridVariables, sol, vtkName);
     using DarcyVelocityOutput =
         GetPropType<DarcyTypeTag, Properties::VelocityOutput>;
     darcyVtkWriter.addVelocityOutput(
         std::make_shared<DarcyVelocityOutput>(*darcyGridVariables));
     GetPropType<DarcyTypeTag, Properties::IOFields>::initOutputModule(
         darcyVtkWriter);
-    darcyVtkWriter.write(0.0);
+    Dumux::Precice::VtkOutputPolicy vtkOutputPolicy;
+    vtkOutputPolicy.setCompletedTimeWindows(restartTimeWindow);
+    darcyVtkWriter.write(vtkTime - 1., vtkOutputPolicy.outputType());
 
     using FluxVariables = GetPropType<DarcyTypeTag, Properties::FluxVariables>;
     if (couplingInterface.hasToWriteInitialData()) {
         //TODO
-        setInterfaceVelocities<FluxVariables>(*darcyProblem,
-                                              *darcyGridVariables, sol);
+        setInterfaceVelocities<FluxVariables>(
+            couplingInterface, velocityId, *darcyProblem, *darcyGridVariables,
+            sol, coupledElements);
         // For testing
         //        {
         //            const auto v = couplingInterface.getQuantityVector(velocityId);
@@ -348,32 +425,75 @@ try {
         darcyProblem, darcyGridGeometry, darcyGridVariables);
 
     // the linear solver
-    using LinearSolver = UMFPackBackend;
+    using LinearSolver = Dumux::Precice::SelectableLinearSolver;
     auto linearSolver = std::make_shared<LinearSolver>();
 
     // the non-linear solver
-    using NewtonSolver = Dumux::NewtonSolver<Assembler, LinearSolver>;
+    using NewtonSolver =
+        Dumux::Precice::JacobianReuseNewtonSolver<Assembler, LinearSolver>;
     NewtonSolver nonLinearSolver(assembler, linearSolver);
 
     auto dt = preciceDt;
-    auto sol_checkpoint = sol;
-
-    double vtkTime = 1.0;
-    size_t iter = 0;
+    const auto checkpointMode =
+        getParam<bool>("Problem.KeepIterateOnCheckpointRead", false)
+            ? Dumux::Precice::CheckpointRestoreMode::KeepIterate
+            : Dumux::Precice::CheckpointRestoreMode::Full;
+    Dumux::Precice::SolutionCheckpoint<decltype(sol)> checkpoint(
+        sol, checkpointMode);
+
+    // skip the solve if the interface data changed less than this tolerance
+    // since the last solve
+    const double interfaceChangeTolerance =
+        getParam<double>("Problem.InterfaceChangeTolerance", 0.0);
+    // interface data of the last solve, only kept if solves may be skipped
+    std::vector<double> solvedPressures;
+    // true if sol solves the problem for the interface data of the last solve
+    bool solutionIsCurrent = false;
+
+    // loosen the Newton tolerance while the interface residual is large,
+    // early coupling iterations are based on data replaced anyway
+    const double inexactToleranceFactor =
+        getParam<double>("Problem.InexactNewtonToleranceFactor", 0.0);
+    const double newtonTolerance =
+        getParam<double>("Newton.MaxRelativeShift", 1e-8);
+    const double maxNewtonTolerance =
+        getParam<double>("Problem.InexactNewtonMaxTolerance", 1e-2);
+    const auto residualLogFileName =
+        getParamFromGroup<std::string>("preCICE", "ResidualLogFileName", "");
+    // both need the interface residual
+    if (inexactToleranceFactor > 0. || !residualLogFileName.empty())
+        couplingInterface.enableChangeTracking(pressureId);
+    if (!residualLogFileName.empty())
+        couplingInterface.enableResidualLog(residualLogFileName);
 
     while (couplingInterface.isCouplingOngoing()) {
         if (couplingInterface.hasToWriteIterationCheckpoint()) {
             //DO CHECKPOINTING
-            sol_checkpoint = sol;
+            checkpoint.store(sol);
             couplingInterface.announceIterationCheckpointWritten();
         }
 
         couplingInterface.readScalarQuantityFromOtherSolver(pressureId);
+        darcyProblem->updateCoupledFaceValues();
 
         // solve the non-linear system
-        nonLinearSolver.solve(sol);
-        setInterfaceVelocities<FluxVariables>(*darcyProblem,
-                                              *darcyGridVariables, sol);
+        if (inexactToleranceFactor > 0.)
+            nonLinearSolver.setMaxRelativeShift(
+                couplingInterface.getInexactSolverTolerance(
+                    newtonTolerance, maxNewtonTolerance,
+                    inexactToleranceFactor));
+        if (!solutionIsCurrent || interfaceChangeTolerance <= 0. ||
+            couplingInterface.getRelativeQuantityChange(
+                pressureId, solvedPressures) >= interfaceChangeTolerance) {
+            nonLinearSolver.solve(sol);
+            if (interfaceChangeTolerance > 0.)
+                solvedPressures =
+                    couplingInterface.getQuantityVector(pressureId);
+        }
+        solutionIsCurrent = true;
+        setInterfaceVelocities<FluxVariables>(
+            couplingInterface, velocityId, *darcyProblem, *darcyGridVariables,
+            sol, coupledElements);
         couplingInterface.writeScalarQuantityToOtherSolver(velocityId);
 
         const double preciceDt = couplingInterface.advance(dt);
@@ -383,21 +503,38 @@ try {
 
         if (couplingInterface.hasToReadIterationCheckpoint()) {
             //Read checkpoint
-            darcyVtkWriter.write(vtkTime);
-            vtkTime += 1.;
-            sol = sol_checkpoint;
-            darcyGridVariables->update(sol);
-            darcyGridVariables->advanceTimeStep();
+            if (vtkOutputPolicy.writeIteration()) {
+                darcyVtkWriter.write(vtkTime, vtkOutputPolicy.outputType());
+                vtkTime += 1.;
+            }
+            checkpoint.restore(sol, *darcyGridVariables);
+            solutionIsCurrent =
+                checkpoint.mode() ==
+                Dumux::Precice::CheckpointRestoreMode::KeepIterate;
             //darcyGridVariables->init(sol);
             couplingInterface.announceIterationCheckpointRead();
         } else  // coupling successful
         {
+            // the Jacobian of the next time window differs
+            nonLinearSolver.invalidateJacobian();
+            linearSolver->resetPreconditioner();
+
             // write vtk output
-            darcyVtkWriter.write(vtkTime);
+            if (vtkOutputPolicy.writeTimeWindow()) {
+                darcyVtkWriter.write(vtkTime, vtkOutputPolicy.outputType());
+                vtkTime += 1.;
+            }
+
+            if (couplingInterface.hasToWriteSnapshot()) {
+                auto snapshotState = Dumux::Precice::flattenSolution(sol);
+                snapshotState.push_back(vtkTime);
+                snapshotState.push_back(double(iter));
+                couplingInterface.writeSnapshot(snapshotState);
+            }
         }
     }
     // write vtk output
-    darcyVtkWriter.write(1.0);
+    darcyVtkWriter.write(1.0, vtkOutputPolicy.outputType());
 
     couplingInterface.finalize();
 
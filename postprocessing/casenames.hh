@@ -0,0 +1,57 @@
+#ifndef DUMUXPRECICE_POSTPROCESSING_CASENAMES_HH
+#define DUMUXPRECICE_POSTPROCESSING_CASENAMES_HH
+
+#include <string>
+
+/*!
+ * @brief Gets the name of the directory of a monolithic reference case.
+ *
+ * @param[in] eq_name Name of the flow problem, `stokes` or `navier-stokes`.
+ * @param[in] n Number of cells in every direction.
+ * @param[in] alpha Beavers-Joseph coefficient.
+ * @param[in] perm Permeability.
+ * @param[in] dp Pressure difference.
+ * @return std::string Name of the case.
+ */
+inline std::string getMonolithicName(const std::string &eq_name,
+                                     const std::string &n,
+                                     const std::string &alpha,
+                                     const std::string &perm,
+                                     const std::string &dp)
+{
+    return eq_name + "-" + n + "-" + alpha + "-" + perm + "-" + dp;
+}
+
+/*!
+ * @brief Gets the name of the directory of a partitioned case.
+ *
+ * The parameter sweep (scripts/parameter-sweep) writes the cases to these
+ * directories and the comparison (postprocessing/vtk) reads them from
+ * there.
+ *
+ * @param[in] eq_name Name of the flow problem, `stokes` or `navier-stokes`.
+ * @param[in] n Number of cells in every direction.
+ * @param[in] alpha Beavers-Joseph coefficient.
+ * @param[in] perm Permeability.
+ * @param[in] dp Pressure difference.
+ * @param[in] caseName Order of the solvers, `stokes-first` or `darcy-first`.
+ * @param[in] preciceRelTol Relative convergence tolerance of preCICE.
+ * @return std::string Name of the case.
+ */
+inline std::string getIterativeName(const std::string &eq_name,
+                                    const std::string &n,
+                                    const std::string &alpha,
+                                    const std::string &perm,
+                                    const std::string &dp,
+                                    const std::string &caseName,
+                                    const std::string &preciceRelTol)
+{
+    std::string name = eq_name + "-" + preciceRelTol + "-" + n + "-" + alpha +
+                       "-" + perm + "-" + dp;
+    if (caseName == "darcy-first") {
+        name += "-darcy-first";
+    }
+    return name;
+}
+
+#endif  // DUMUXPRECICE_POSTPROCESSING_CASENAMES_HH
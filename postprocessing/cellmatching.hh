@@ -0,0 +1,241 @@
+#ifndef DUMUXPRECICE_POSTPROCESSING_CELLMATCHING_HH
+#define DUMUXPRECICE_POSTPROCESSING_CELLMATCHING_HH
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*!
+ * @brief Sums and maxima of the difference of two datasets and of the
+ *        second dataset, the building blocks of the l1, l2 and linf errors.
+ */
+struct ErrorSums {
+    double diffL1 = 0.;
+    double diffL2Squared = 0.;
+    double diffLinf = 0.;
+    double normL1 = 0.;
+    double normL2Squared = 0.;
+    double normLinf = 0.;
+};
+
+/*!
+ * @brief Computes the error sums of a scalar field.
+ *
+ * The loop is a plain reduction over contiguous arrays so that it is
+ * vectorized.
+ *
+ * @param[in] a Values of the first dataset.
+ * @param[in] b Values of the second dataset.
+ * @param[in] size Number of values.
+ * @return ErrorSums The sums of the difference and of the second dataset.
+ */
+inline ErrorSums scalarErrorSums(const double *a,
+                                 const double *b,
+                                 const std::size_t size)
+{
+    double diffL1 = 0., diffL2Squared = 0., diffLinf = 0.;
+    double normL1 = 0., normL2Squared = 0., normLinf = 0.;
+#pragma omp simd reduction(+ : diffL1, diffL2Squared, normL1, normL2Squared) \
+    reduction(max : diffLinf, normLinf)
+    for (std::size_t i = 0; i < size; ++i) {
+        const double diff = std::fabs(a[i] - b[i]);
+        const double norm = std::fabs(b[i]);
+        diffL1 += diff;
+        diffL2Squared += diff * diff;
+        diffLinf = std::max(diff, diffLinf);
+        normL1 += norm;
+        normL2Squared += norm * norm;
+        normLinf = std::max(norm, normLinf);
+    }
+    return {diffL1, diffL2Squared, diffLinf, normL1, normL2Squared, normLinf};
+}
+
+/*!
+ * @brief Computes the error sums of a two-component vector field.
+ *
+ * The l1 and l2 sums run over both components, the linf norms are the
+ * maximum over both components.
+ *
+ * @param[in] uA First component of the first dataset.
+ * @param[in] vA Second component of the first dataset.
+ * @param[in] uB First component of the second dataset.
+ * @param[in] vB Second component of the second dataset.
+ * @param[in] size Number of values per component.
+ * @return ErrorSums The sums of the difference and of the second dataset.
+ */
+inline ErrorSums vectorErrorSums(const double *uA,
+                                 const double *vA,
+                                 const double *uB,
+                                 const double *vB,
+                                 const std::size_t size)
+{
+    double diffL1 = 0., diffL2Squared = 0., diffLinf = 0.;
+    double normL1 = 0., normL2Squared = 0., normLinf = 0.;
+#pragma omp simd reduction(+ : diffL1, diffL2Squared, normL1, normL2Squared) \
+    reduction(max : diffLinf, normLinf)
+    for (std::size_t i = 0; i < size; ++i) {
+        const double du = std::fabs(uA[i] - uB[i]);
+        const double dv = std::fabs(vA[i] - vB[i]);
+        const double nu = std::fabs(uB[i]);
+        const double nv = std::fabs(vB[i]);
+        diffL1 += du + dv;
+        diffL2Squared += du * du + dv * dv;
+        diffLinf = std::max(std::max(du, dv), diffLinf);
+        normL1 += nu + nv;
+        normL2Squared += nu * nu + nv * nv;
+        normLinf = std::max(std::max(nu, nv), normLinf);
+    }
+    return {diffL1, diffL2Squared, diffLinf, normL1, normL2Squared, normLinf};
+}
+
+/*!
+ * @brief Computes the tolerance two cell centers are considered equal with.
+ *
+ * The tolerance is at least minimumTolerance, e.g. if all coordinates are
+ * zero. Otherwise the grid of matchCellCenters would get cells of
+ * vanishing size and the cell keys would overflow.
+ *
+ * @param[in] cellCenters Cell centers of the reference dataset.
+ * @param[in] relativeTolerance Tolerance relative to the largest coordinate.
+ * @param[in] minimumTolerance Lower bound of the absolute tolerance.
+ * @return double The absolute tolerance.
+ */
+inline double cellCenterTolerance(
+    const std::vector<std::array<double, 3> > &cellCenters,
+    const double relativeTolerance,
+    const double minimumTolerance = 1e-12)
+{
+    double maxCoordinate = 0.;
+    for (const auto &center : cellCenters)
+        for (int d = 0; d < 3; ++d)
+            maxCoordinate = std::max(std::fabs(center[d]), maxCoordinate);
+    return std::max(relativeTolerance * maxCoordinate, minimumTolerance);
+}
+
+/*!
+ * @brief Computes for every cell of the reference the matching cell of
+ *        another dataset.
+ *
+ * The cell centers of the dataset are hashed into a uniform grid with the
+ * tolerance as cell size. Every reference cell then only looks at the 27
+ * neighbouring grid cells, so the matching takes O(n) expected time.
+ *
+ * @param[in] reference Cell centers of the reference dataset.
+ * @param[in] data Cell centers of the dataset to match.
+ * @param[in] tolerance Absolute distance (per coordinate) of matching cells.
+ * @return std::vector<std::size_t> Index in data for every reference cell.
+ */
+inline std::vector<std::size_t> matchCellCenters(
+    const std::vector<std::array<double, 3> > &reference,
+    const std::vector<std::array<double, 3> > &data,
+    const double tolerance)
+{
+    using Key = std::array<std::int64_t, 3>;
+    struct KeyHash {
+        std::size_t operator()(const Key &key) const
+        {
+            return std::size_t(key[0] * 73856093) ^
+                   std::size_t(key[1] * 19349663) ^
+                   std::size_t(key[2] * 83492791);
+        }
+    };
+    auto keyOf = [tolerance](const std::array<double, 3> &center) {
+        Key key;
+        for (int d = 0; d < 3; ++d)
+            key[d] = std::int64_t(std::floor(center[d] / tolerance));
+        return key;
+    };
+
+    std::unordered_map<Key, std::vector<std::size_t>, KeyHash> grid;
+    grid.reserve(data.size());
+    for (std::size_t i = 0; i < data.size(); ++i)
+        grid[keyOf(data[i])].push_back(i);
+
+    constexpr std::size_t unmatched = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> matches(reference.size(), unmatched);
+    std::vector<bool> isMatched(data.size(), false);
+    for (std::size_t i = 0; i < reference.size(); ++i) {
+        const auto &center = reference[i];
+        const Key key = keyOf(center);
+        double bestDistance = tolerance;
+        for (std::int64_t dx = -1; dx <= 1; ++dx)
+            for (std::int64_t dy = -1; dy <= 1; ++dy)
+                for (std::int64_t dz = -1; dz <= 1; ++dz) {
+                    const auto bucket =
+                        grid.find({key[0] + dx, key[1] + dy, key[2] + dz});
+                    if (bucket == grid.end())
+                        continue;
+                    for (const auto j : bucket->second) {
+                        double distance = 0.;
+                        for (int d = 0; d < 3; ++d)
+                            distance = std::max(
+                                std::fabs(center[d] - data[j][d]), distance);
+                        if (!isMatched[j] && distance <= bestDistance) {
+                            bestDistance = distance;
+                            matches[i] = j;
+                        }
+                    }
+                }
+        if (matches[i] == unmatched)
+            throw std::runtime_error("Cell " + std::to_string(i) +
+                                     " has no matching cell!");
+        isMatched[matches[i]] = true;
+    }
+    return matches;
+}
+
+/*!
+ * @brief Brings the cells of a dataset into the order of the reference.
+ *
+ * Nothing is done if the cells are already in the same order. Otherwise,
+ * e.g. for partitioned or reordered output, the cells are matched by their
+ * centers and the fields of the dataset are permuted accordingly.
+ *
+ * @tparam CellData Cell data with the fields u, v, p and cellCenters.
+ * @param[in] reference The reference dataset.
+ * @param[in,out] data The dataset to reorder.
+ * @param[in] log Stream the reordering is reported to.
+ */
+template<class CellData>
+void alignCells(const CellData &reference, CellData &data, std::ostream &log)
+{
+    if (reference.size != data.size) {
+        throw std::runtime_error("Datasets have different sizes!");
+    }
+    constexpr double prec = 1e-8;
+    const double tolerance = cellCenterTolerance(reference.cellCenters, prec);
+
+    bool sameOrder = true;
+    for (std::size_t i = 0; i < reference.size && sameOrder; ++i)
+        for (int d = 0; d < 3; ++d)
+            sameOrder = sameOrder && std::fabs(reference.cellCenters[i][d] -
+                                               data.cellCenters[i][d]) <=
+                                         tolerance;
+    if (sameOrder)
+        return;
+
+    log << "Cells are ordered differently, matching them by their centers"
+        << std::endl;
+    const auto matches =
+        matchCellCenters(reference.cellCenters, data.cellCenters, tolerance);
+    auto permute = [&matches](auto &values) {
+        auto permuted = values;
+        for (std::size_t i = 0; i < matches.size(); ++i)
+            permuted[i] = values[matches[i]];
+        values.swap(permuted);
+    };
+    permute(data.u);
+    permute(data.v);
+    permute(data.p);
+    permute(data.cellCenters);
+}
+
+#endif  // DUMUXPRECICE_POSTPROCESSING_CELLMATCHING_HH
@@ -17,6 +17,9 @@
 
 #include <iomanip>
 #include <iostream>
+
+#include "cellmatching.hh"
+
 // the data for one timestep
 struct CellData {
     std::vector<double> u;
@@ -55,47 +58,6 @@ struct Errors {
     ErrorsBase dataset_norm;
 };
 
-void checkCellCenters(const CellData &cellDataA, const CellData &cellDataB)
-{
-    //  if ( pda->Get )
-    //vtkPolyData* asdf;
-    //asdf->GetPo
-    if (cellDataA.size != cellDataB.size) {
-        throw std::runtime_error("Datasets have different sizes!");
-    }
-    constexpr double prec = 1e-8;
-
-    double normLinf = std::numeric_limits<double>::min();
-    double normLinfB = std::numeric_limits<double>::min();
-
-    for (size_t i = 0; i < cellDataA.size; ++i) {
-        const auto &pa = cellDataA.cellCenters[i];
-        const auto &pb = cellDataB.cellCenters[i];
-
-        double normLinfLocal = std::numeric_limits<double>::min();
-        for (int d = 0; d < 3; ++d) {
-            normLinfLocal = std::max(std::fabs(pa[d] - pb[d]), normLinfLocal);
-            normLinfB = std::max(std::fabs(pb[d]), normLinfB);
-        }
-        normLinf = std::max(normLinfLocal, normLinf);
-        if (normLinfLocal > prec) {
-            std::cout << "Point " << i << "deviates!" << std::endl
-                      << "  Dataset A: " << pa[0] << ", " << pa[1] << ", "
-                      << pa[2] << std::endl
-                      << "  Dataset B: " << pb[0] << ", " << pb[1] << ", "
-                      << pb[2] << std::endl;
-        }
-    }
-    const double normLinfRel = normLinf / normLinfB;
-    //  std::cout << "Coordinate deviations: " << std::endl
-    //            << "  linf-norm: " << normLinf << " (abs), "
-    //            << normLinfRel << "(rel)" << std::endl;
-
-    if (normLinfRel > prec) {
-        throw std::runtime_error("Coordinates deviate too much!");
-    }
-}
-
 vtkPolyData *getPolyDataFromFile(const std::string &filename)
 {
     vtkSmartPointer<vtkXMLUnstructuredGridReader> reader =
@@ -198,31 +160,15 @@ Errors computePressureError(const CellData &dataSetA, const CellData &dataSetB)
     Errors pressureErrors;
     ErrorsBase errP;
 
-    for (size_t i = 0; i < dataSetA.size; ++i) {
-        pressureErrors.abs.l1 += std::fabs(dataSetA.p[i] - dataSetB.p[i]);
-
-        errP.l1 += std::fabs(dataSetB.p[i]);
+    const ErrorSums sums = scalarErrorSums(
+        dataSetA.p.data(), dataSetB.p.data(), dataSetA.size);
+    pressureErrors.abs.l1 = sums.diffL1;
+    pressureErrors.abs.l2 = std::sqrt(sums.diffL2Squared);
+    pressureErrors.abs.linf = sums.diffLinf;
 
-        pressureErrors.abs.l2 += std::pow(dataSetA.p[i] - dataSetB.p[i], 2);
-        errP.l2 += std::pow(dataSetB.p[i], 2);
-
-        pressureErrors.abs.linf = std::max(
-            std::fabs(dataSetA.p[i] - dataSetB.p[i]), pressureErrors.abs.linf);
-
-        errP.linf = std::max(std::fabs(dataSetB.p[i]), errP.linf);
-
-        constexpr double tol = 1e-10;
-        if (std::fabs(dataSetA.p[i] - dataSetB.p[i]) > tol) {
-            //      std::cout << "Large error " << std::fabs(dataSetA.p[i] - dataSetB.p[i] ) << " (p) at Point " << i << std::endl
-            //                << "  Coords: " << dataSetA.cellCenters[i][0] << ", "
-            //                << dataSetA.cellCenters[i][1] << ", "
-            //                << dataSetA.cellCenters[i][2] << ", "
-            //                << std::endl;
-        }
-    }
-    pressureErrors.abs.l2 = std::sqrt(pressureErrors.abs.l2);
-
-    errP.l2 = std::sqrt(errP.l2);
+    errP.l1 = sums.normL1;
+    errP.l2 = std::sqrt(sums.normL2Squared);
+    errP.linf = sums.normLinf;
 
     pressureErrors.rel.l1 = pressureErrors.abs.l1 / errP.l1;
     pressureErrors.rel.l2 = pressureErrors.abs.l2 / errP.l2;
@@ -254,36 +200,16 @@ Errors computeVelocityError(const CellData &dataSetA, const CellData &dataSetB)
     assert(dataSetA.size == dataSetB.size);
     Errors velocityErrors;
     ErrorsBase errV;
-    for (size_t i = 0; i < dataSetA.size; ++i) {
-        velocityErrors.abs.l1 += std::fabs(dataSetA.u[i] - dataSetB.u[i]) +
-                                 std::fabs(dataSetA.v[i] - dataSetB.v[i]);
-        errV.l1 += std::fabs(dataSetB.u[i]) + std::fabs(dataSetB.v[i]);
-
-        velocityErrors.abs.l2 += std::pow(dataSetA.u[i] - dataSetB.u[i], 2) +
-                                 std::pow(dataSetA.v[i] - dataSetB.v[i], 2);
-
-        errV.l2 += std::pow(dataSetB.u[i], 2) + std::pow(dataSetB.v[i], 2);
-
-        const double u = std::fabs(dataSetA.u[i] - dataSetB.u[i]);
-        const double v = std::fabs(dataSetA.v[i] - dataSetB.v[i]);
-        const double uvMax = std::max(u, v);
-        velocityErrors.abs.linf = std::max(uvMax, velocityErrors.abs.linf);
-
-        errV.linf = std::max(std::fabs(dataSetB.u[i]), errV.linf);
-        errV.linf = std::max(std::fabs(dataSetB.v[i]), errV.linf);
-
-        constexpr double tol = 1e-10;
-        if (uvMax > tol) {
-            //      std::cout << "Large error " << uvMax << " at Point " << i << std::endl
-            //                << "  Coords: " << dataSetA.cellCenters[i][0] << ", "
-            //                << dataSetA.cellCenters[i][1] << ", "
-            //                << dataSetA.cellCenters[i][2] << ", "
-            //                << std::endl;
-        }
-    }
-    velocityErrors.abs.l2 = std::sqrt(velocityErrors.abs.l2);
+    const ErrorSums sums =
+        vectorErrorSums(dataSetA.u.data(), dataSetA.v.data(), dataSetB.u.data(),
+                        dataSetB.v.data(), dataSetA.size);
+    velocityErrors.abs.l1 = sums.diffL1;
+    velocityErrors.abs.l2 = std::sqrt(sums.diffL2Squared);
+    velocityErrors.abs.linf = sums.diffLinf;
 
-    errV.l2 = std::sqrt(errV.l2);
+    errV.l1 = sums.normL1;
+    errV.l2 = std::sqrt(sums.normL2Squared);
+    errV.linf = sums.normLinf;
 
     velocityErrors.rel.l1 = velocityErrors.abs.l1 / errV.l1;
     velocityErrors.rel.l2 = velocityErrors.abs.l2 / errV.l2;
@@ -310,10 +236,10 @@ Errors computeVelocityError(const CellData &dataSetA, const CellData &dataSetB)
     return std::move(velocityErrors);
 }
 
-std::tuple<Errors, Errors> computeErrors(const CellData &dataA,
-                                         const CellData &dataB)
+// dataB is brought into the cell order of dataA
+std::tuple<Errors, Errors> computeErrors(const CellData &dataA, CellData &dataB)
 {
-    checkCellCenters(dataA, dataB);
+    alignCells(dataA, dataB, std::cout);
     std::cout.precision(6);
     std::cout << std::scientific;
     const Errors pressureErrors = computePressureError(dataA, dataB);
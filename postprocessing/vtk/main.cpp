@@ -17,9 +17,20 @@
 //#include <experimental/filesystem>
 //using namespace std::experimental::filesystem;
 
+#include <atomic>
+#include <exception>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
 #include "boost/filesystem.hpp"
+#include "casenames.hh"
+#include "cellmatching.hh"
 using namespace boost::filesystem;
 
 static constexpr unsigned outputPrecision = 10;
@@ -71,33 +82,13 @@ struct AllErrors {
     //  Errors total;
 };
 
-std::string getMonolithicName(const std::string &eq_name,
-                              const std::string &n,
-                              const std::string &alpha,
-                              const std::string &perm,
-                              const std::string &dp)
-{
-    return eq_name + "-" + n + "-" + alpha + "-" + perm + "-" + dp;
-}
-
-std::string getIterativeName(const std::string &eq_name,
-                             const std::string &n,
-                             const std::string &alpha,
-                             const std::string &perm,
-                             const std::string &dp,
-                             const std::string &caseName,
-                             const std::string &preciceRelTol)
-{
-    std::string name = eq_name + "-" + preciceRelTol + "-" + n + "-" + alpha +
-                       "-" + perm + "-" + dp;
-    if (caseName == "darcy-first") {
-        name += "-darcy-first";
-    }
-    return name;
-}
-
-std::string findLastVtu(const std::string &problemName,
-                        const std::string &directory)
+/*!
+ * @brief Lists the vtu files of a directory, sorted by filename.
+ *
+ * The directory is only scanned once, all files of the case are then
+ * looked up in the list.
+ */
+std::vector<std::string> listVtus(const std::string &directory)
 {
     // get files in directory
     std::vector<std::string> filenames;
@@ -110,8 +101,7 @@ std::string findLastVtu(const std::string &problemName,
         if (is_regular_file(iter->status())) {
             std::string filename(iter->path().string());
 
-            if (filename.find(".vtu") != std::string::npos &&
-                filename.find(problemName) != std::string::npos) {
+            if (filename.find(".vtu") != std::string::npos) {
                 filenames.push_back(filename);
             }
         }
@@ -120,7 +110,20 @@ std::string findLastVtu(const std::string &problemName,
     // sort files by filename
     std::sort(filenames.begin(), filenames.end());
 
-    return filenames.back();
+    return filenames;
+}
+
+std::string findLastVtu(const std::string &problemName,
+                        const std::vector<std::string> &filenames)
+{
+    const auto last = std::find_if(
+        filenames.rbegin(), filenames.rend(), [&](const std::string &filename) {
+            return filename.find(problemName) != std::string::npos;
+        });
+    if (last == filenames.rend()) {
+        throw std::runtime_error("No vtu file found for " + problemName);
+    }
+    return *last;
 }
 
 void FindAllData(vtkPolyData *polydata)
@@ -166,44 +169,6 @@ void printData(const vtkUnstructuredGrid *unstructuredGrid)
     //unstructuredGrid->Get
 }
 
-void checkCellCenters(const CellData &cellDataA, const CellData &cellDataB)
-{
-    //  if ( pda->Get )
-    //vtkPolyData* asdf;
-    //asdf->GetPo
-    if (cellDataA.size != cellDataB.size) {
-        throw std::runtime_error("Datasets have different sizes!");
-    }
-    constexpr double prec = 1e-8;
-
-    double normLinf = std::numeric_limits<double>::min();
-    double normLinfB = std::numeric_limits<double>::min();
-
-    for (size_t i = 0; i < cellDataA.size; ++i) {
-        const auto &pa = cellDataA.cellCenters[i];
-        const auto &pb = cellDataB.cellCenters[i];
-
-        double normLinfLocal = std::numeric_limits<double>::min();
-        for (int d = 0; d < 3; ++d) {
-            normLinfLocal = std::max(std::fabs(pa[d] - pb[d]), normLinfLocal);
-            normLinfB = std::max(std::fabs(pb[d]), normLinfB);
-        }
-        normLinf = std::max(normLinfLocal, normLinf);
-        if (normLinfLocal > prec) {
-            std::cout << "Point " << i << "deviates!" << std::endl
-                      << "  Dataset A: " << pa[0] << ", " << pa[1] << ", "
-                      << pa[2] << std::endl
-                      << "  Dataset B: " << pb[0] << ", " << pb[1] << ", "
-                      << pb[2] << std::endl;
-        }
-    }
-    const double normLinfRel = normLinf / normLinfB;
-
-    if (normLinfRel > prec) {
-        throw std::runtime_error("Coordinates deviate too much!");
-    }
-}
-
 vtkPolyData *getPolyDataFromFile(const std::string &filename)
 {
     vtkSmartPointer<vtkXMLUnstructuredGridReader> reader =
@@ -222,7 +187,9 @@ vtkPolyData *getPolyDataFromFile(const std::string &filename)
     return surfaceFilter->GetOutput();
 }
 
-void parseData(const std::string &filename, CellData &cellData)
+void parseData(const std::string &filename,
+               CellData &cellData,
+               std::ostream &log)
 {
     vtkSmartPointer<vtkXMLUnstructuredGridReader> reader =
         vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
@@ -240,8 +207,8 @@ void parseData(const std::string &filename, CellData &cellData)
     surfaceFilter->GetOutput();
     vtkPolyData *polydata = surfaceFilter->GetOutput();
 
-    std::cout << "Output has " << polydata->GetNumberOfPoints() << " points."
-              << std::endl;
+    log << "Output has " << polydata->GetNumberOfPoints() << " points."
+        << std::endl;
 
     vtkIdType pressureId = -1;
     vtkIdType velocityId = -1;
@@ -294,130 +261,196 @@ void parseData(const std::string &filename, CellData &cellData)
     }
 }
 
-Errors computePressureError(const CellData &dataSetA, const CellData &dataSetB)
+Errors computePressureError(const CellData &dataSetA,
+                            const CellData &dataSetB,
+                            std::ostream &log)
 {
     assert(dataSetA.size == dataSetB.size);
     Errors errorsPressure;
     ErrorsBase errP;
 
-    for (size_t i = 0; i < dataSetA.size; ++i) {
-        errorsPressure.abs.l1 += std::fabs(dataSetA.p[i] - dataSetB.p[i]);
-
-        errP.l1 += std::fabs(dataSetB.p[i]);
+    const ErrorSums sums = scalarErrorSums(
+        dataSetA.p.data(), dataSetB.p.data(), dataSetA.size);
+    errorsPressure.abs.l1 = sums.diffL1;
+    errorsPressure.abs.l2 = std::sqrt(sums.diffL2Squared);
+    errorsPressure.abs.linf = sums.diffLinf;
 
-        errorsPressure.abs.l2 += std::pow(dataSetA.p[i] - dataSetB.p[i], 2);
-        errP.l2 += std::pow(dataSetB.p[i], 2);
-
-        errorsPressure.abs.linf = std::max(
-            std::fabs(dataSetA.p[i] - dataSetB.p[i]), errorsPressure.abs.linf);
-
-        errP.linf = std::max(std::fabs(dataSetB.p[i]), errP.linf);
-
-        constexpr double tol = 1e-10;
-        if (std::fabs(dataSetA.p[i] - dataSetB.p[i]) > tol) {
-            //      std::cout << "Large error " << std::fabs(dataSetA.p[i] - dataSetB.p[i] ) << " (p) at Point " << i << std::endl
-            //                << "  Coords: " << dataSetA.cellCenters[i][0] << ", "
-            //                << dataSetA.cellCenters[i][1] << ", "
-            //                << dataSetA.cellCenters[i][2] << ", "
-            //                << std::endl;
-        }
-    }
-    errorsPressure.abs.l2 = std::sqrt(errorsPressure.abs.l2);
-
-    errP.l2 = std::sqrt(errP.l2);
+    errP.l1 = sums.normL1;
+    errP.l2 = std::sqrt(sums.normL2Squared);
+    errP.linf = sums.normLinf;
 
     errorsPressure.rel.l1 = errorsPressure.abs.l1 / errP.l1;
     errorsPressure.rel.l2 = errorsPressure.abs.l2 / errP.l2;
     errorsPressure.rel.linf = errorsPressure.abs.linf / errP.linf;
 
-    std::cout << "Errors: " << std::endl
-              << "  p: " << std::endl
-              << "    " << errorsPressure.abs.l1 << " (l1), "
-              << errorsPressure.rel.l1 << ", " << errP.l1 << std::endl
-              << "    " << errorsPressure.abs.l2 << " (l2), "
-              << errorsPressure.rel.l2 << ", " << errP.l2 << std::endl
-              << "    " << errorsPressure.abs.linf << " (linf), "
-              << errorsPressure.rel.linf << ", " << errP.linf << std::endl;
+    log << "Errors: " << std::endl
+        << "  p: " << std::endl
+        << "    " << errorsPressure.abs.l1 << " (l1), "
+        << errorsPressure.rel.l1 << ", " << errP.l1 << std::endl
+        << "    " << errorsPressure.abs.l2 << " (l2), "
+        << errorsPressure.rel.l2 << ", " << errP.l2 << std::endl
+        << "    " << errorsPressure.abs.linf << " (linf), "
+        << errorsPressure.rel.linf << ", " << errP.linf << std::endl;
 
     return errorsPressure;
 }
 
-Errors computeVelocityError(const CellData &dataSetA, const CellData &dataSetB)
+Errors computeVelocityError(const CellData &dataSetA,
+                            const CellData &dataSetB,
+                            std::ostream &log)
 {
     assert(dataSetA.size == dataSetB.size);
     Errors errorsVelocity;
     ErrorsBase errV;
-    for (size_t i = 0; i < dataSetA.size; ++i) {
-        errorsVelocity.abs.l1 += std::fabs(dataSetA.u[i] - dataSetB.u[i]) +
-                                 std::fabs(dataSetA.v[i] - dataSetB.v[i]);
-        errV.l1 += std::fabs(dataSetB.u[i]) + std::fabs(dataSetB.v[i]);
-
-        errorsVelocity.abs.l2 += std::pow(dataSetA.u[i] - dataSetB.u[i], 2) +
-                                 std::pow(dataSetA.v[i] - dataSetB.v[i], 2);
-
-        errV.l2 += std::pow(dataSetB.u[i], 2) + std::pow(dataSetB.v[i], 2);
-
-        const double u = std::fabs(dataSetA.u[i] - dataSetB.u[i]);
-        const double v = std::fabs(dataSetA.v[i] - dataSetB.v[i]);
-        const double uvMax = std::max(u, v);
-        errorsVelocity.abs.linf = std::max(uvMax, errorsVelocity.abs.linf);
-
-        errV.linf = std::max(std::fabs(dataSetB.u[i]), errV.linf);
-        errV.linf = std::max(std::fabs(dataSetB.v[i]), errV.linf);
-
-        constexpr double tol = 1e-10;
-        if (uvMax > tol) {
-            //      std::cout << "Large error " << uvMax << " at Point " << i << std::endl
-            //                << "  Coords: " << dataSetA.cellCenters[i][0] << ", "
-            //                << dataSetA.cellCenters[i][1] << ", "
-            //                << dataSetA.cellCenters[i][2] << ", "
-            //                << std::endl;
-        }
-    }
-    errorsVelocity.abs.l2 = std::sqrt(errorsVelocity.abs.l2);
+    const ErrorSums sums =
+        vectorErrorSums(dataSetA.u.data(), dataSetA.v.data(), dataSetB.u.data(),
+                        dataSetB.v.data(), dataSetA.size);
+    errorsVelocity.abs.l1 = sums.diffL1;
+    errorsVelocity.abs.l2 = std::sqrt(sums.diffL2Squared);
+    errorsVelocity.abs.linf = sums.diffLinf;
 
-    errV.l2 = std::sqrt(errV.l2);
+    errV.l1 = sums.normL1;
+    errV.l2 = std::sqrt(sums.normL2Squared);
+    errV.linf = sums.normLinf;
 
     errorsVelocity.rel.l1 = errorsVelocity.abs.l1 / errV.l1;
     errorsVelocity.rel.l2 = errorsVelocity.abs.l2 / errV.l2;
     errorsVelocity.rel.linf = errorsVelocity.abs.linf / errV.linf;
 
-    std::cout << "Errors: " << std::endl
-              << "  vel: " << std::endl
-              << "    " << errorsVelocity.abs.l1 << " (l1), "
-              << errorsVelocity.rel.l1 << ", " << errV.l1 << std::endl
-              << "    " << errorsVelocity.abs.l2 << " (l2), "
-              << errorsVelocity.rel.l2 << ", " << errV.l2 << std::endl
-              << "    " << errorsVelocity.abs.linf << " (linf), "
-              << errorsVelocity.rel.linf << ", " << errV.linf << std::endl;
+    log << "Errors: " << std::endl
+        << "  vel: " << std::endl
+        << "    " << errorsVelocity.abs.l1 << " (l1), "
+        << errorsVelocity.rel.l1 << ", " << errV.l1 << std::endl
+        << "    " << errorsVelocity.abs.l2 << " (l2), "
+        << errorsVelocity.rel.l2 << ", " << errV.l2 << std::endl
+        << "    " << errorsVelocity.abs.linf << " (linf), "
+        << errorsVelocity.rel.linf << ", " << errV.linf << std::endl;
 
     return errorsVelocity;
 }
 
+// dataB is brought into the cell order of dataA
 std::tuple<AllErrors, AllErrors> computeErrors(const ParsedData &dataA,
-                                               const ParsedData &dataB)
+                                               ParsedData &dataB,
+                                               std::ostream &log)
 {
     AllErrors pressureErrors;
     AllErrors velocityErrors;
     //Stokes error
     {
-        checkCellCenters(dataA.stokes, dataB.stokes);
+        alignCells(dataA.stokes, dataB.stokes, log);
         pressureErrors.stokes =
-            computePressureError(dataA.stokes, dataB.stokes);
+            computePressureError(dataA.stokes, dataB.stokes, log);
         velocityErrors.stokes =
-            computeVelocityError(dataA.stokes, dataB.stokes);
+            computeVelocityError(dataA.stokes, dataB.stokes, log);
     }
 
     //Darcy error
     {
-        checkCellCenters(dataA.darcy, dataB.darcy);
-        pressureErrors.darcy = computePressureError(dataA.darcy, dataB.darcy);
-        velocityErrors.darcy = computeVelocityError(dataA.darcy, dataB.darcy);
+        alignCells(dataA.darcy, dataB.darcy, log);
+        pressureErrors.darcy =
+            computePressureError(dataA.darcy, dataB.darcy, log);
+        velocityErrors.darcy =
+            computeVelocityError(dataA.darcy, dataB.darcy, log);
     }
 
     return std::make_tuple(pressureErrors, velocityErrors);
 }
 
+/*!
+ * @brief Calls f(i) for all i in [0, n) on a pool of threads.
+ *
+ * The first exception thrown by f is rethrown once all threads are done.
+ */
+template<class Function>
+void parallelFor(const size_t n, const unsigned numThreads, Function f)
+{
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&]() {
+        for (size_t i = next++; i < n; i = next++) {
+            try {
+                f(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < numThreads; ++t)
+        threads.emplace_back(worker);
+    worker();
+    for (auto &thread : threads)
+        thread.join();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+// the monolithic solution the iterative solutions are compared to
+struct ReferenceCase {
+    std::string directory;
+    std::string equationName;
+    ParsedData data;
+};
+
+// one pair of result files, one row per preCICE tolerance
+struct ComparisonSeries {
+    std::string couplingType;
+    std::string resultName;
+    size_t reference;
+    std::vector<size_t> comparisons;
+};
+
+// the comparison of one iterative solution with its reference
+struct Comparison {
+    std::string directory;
+    std::string equationName;
+    std::string preciceRelTol;
+    size_t reference;
+    AllErrors pressureErrors;
+    AllErrors velocityErrors;
+};
+
+void writeErrorHeader(std::ofstream &file, const std::string &quantity)
+{
+    file << "precice_rel_tol"
+         << ","
+         << "err_" << quantity << "_stokes_l1_abs"
+         << ","
+         << "err_stokes_l1_rel";
+    for (const std::string domain : {"stokes", "darcy"}) {
+        for (const std::string norm : {"l1", "l2", "linf"}) {
+            for (const std::string type : {"abs", "rel"}) {
+                if (domain == "stokes" && norm == "l1")
+                    continue;
+                file << ","
+                     << "err_" << quantity << "_" << domain << "_" << norm
+                     << "_" << type;
+            }
+        }
+    }
+    file << std::endl;
+}
+
+void writeErrorRow(std::ofstream &file,
+                   const std::string &preciceRelTol,
+                   const AllErrors &errors)
+{
+    file << std::setprecision(outputPrecision) << std::scientific;
+    file << preciceRelTol << "," << errors.stokes.abs.l1 << ","
+         << errors.stokes.rel.l1 << "," << errors.stokes.abs.l2 << ","
+         << errors.stokes.rel.l2 << "," << errors.stokes.abs.linf << ","
+         << errors.stokes.rel.linf << "," << errors.darcy.abs.l1 << ","
+         << errors.darcy.rel.l1 << "," << errors.darcy.abs.l2 << ","
+         << errors.darcy.rel.l2 << "," << errors.darcy.abs.linf << ","
+         << errors.darcy.rel.linf << std::endl;
+}
+
 int main(int argc, char *argv[])
 {
     // parse command line arguments
@@ -426,6 +459,11 @@ int main(int argc, char *argv[])
     //    std::cout << "usage: " << argv[0] << " <testcasename> <directory to test> <directory with reference data>" << std::endl;
     //    exit(-1);
     //  }
+    // the cases are processed concurrently, optionally limit the threads
+    unsigned numThreads = std::max(1u, std::thread::hardware_concurrency());
+    if (argc > 1) {
+        numThreads = std::max(1, std::atoi(argv[1]));
+    }
 
     const std::vector<std::string> couplingTypes = {"serial-implicit",
                                                     "parallel-implicit"};
@@ -443,251 +481,62 @@ int main(int argc, char *argv[])
     const std::string monolithicRootDir = "../../results/monolithic";
     const std::string iterativeRootDir = "../../results/iterative";
 
-    {
-        for (const auto &couplingType : couplingTypes) {
-            ParsedData monolithicData;
-            ParsedData iterativeData;
-            for (const auto isNavierStokes : hasInertiaTerms) {
-                const std::string equationName =
-                    (isNavierStokes) ? "navier-stokes" : "stokes";
-                for (const auto &meshSize : meshSizes) {
-                    const double h = 1. / std::atof(meshSize.c_str());
-                    for (const auto &alpha : alpha_BJS) {
-                        for (const auto &permeability : permeabilities) {
-                            for (const auto &dp : pressureDifferences) {
-                                //Parse
-                                {
-                                    const std::string &monolithicDir =
-                                        monolithicRootDir + "/" +
-                                        getMonolithicName(equationName,
-                                                          meshSize, alpha,
-                                                          permeability, dp);
-                                    std::cout << "Parsing monolithic data from "
-                                              << monolithicDir << std::endl;
-                                    const std::string &flowFilename =
-                                        findLastVtu("_" + equationName,
-                                                    monolithicDir);
-                                    std::cout << "Loading monolithic free-flow "
-                                                 "data from: "
-                                              << std::endl
-                                              << "  " << flowFilename
-                                              << std::endl;
-                                    parseData(flowFilename,
-                                              monolithicData.stokes);
-                                    const std::string &darcyFilename =
-                                        findLastVtu("_darcy", monolithicDir);
-                                    std::cout << "Loading monolithic "
-                                                 "porous-media-flow data from: "
-                                              << std::endl
-                                              << "  " << darcyFilename
-                                              << std::endl;
-                                    parseData(darcyFilename,
-                                              monolithicData.darcy);
-                                }
-
-                                for (const auto &preciceCase : preciceCases) {
-                                    const std::string caseName =
-                                        (preciceCase == "serial-implicit")
-                                            ? "stokes-first"
-                                            : "darcy-first";
-                                    std::ofstream velocityErrorFile;
-                                    std::ofstream pressureErrorFile;
-                                    {
-                                        const std::string monolithicString =
-                                            getMonolithicName(equationName,
-                                                              meshSize, alpha,
-                                                              permeability, dp);
-                                        {
-                                            const std::string resultFilename =
-                                                couplingType + "-errors-u-" +
-                                                monolithicString + "-" +
-                                                caseName + ".csv";
-                                            velocityErrorFile.open(
-                                                resultFilename,
-                                                std::ofstream::trunc);
-
-                                            velocityErrorFile
-                                                << "precice_rel_tol"
-                                                << ","
-                                                << "err_u_stokes_l1_abs"
-                                                << ","
-                                                << "err_stokes_l1_rel"
-                                                << ","
-                                                << "err_u_stokes_l2_abs"
-                                                << ","
-                                                << "err_u_stokes_l2_rel"
-                                                << ","
-                                                << "err_u_stokes_linf_abs"
-                                                << ","
-                                                << "err_u_stokes_linf_rel"
-                                                << ","
-                                                << "err_u_darcy_l1_abs"
-                                                << ","
-                                                << "err_u_darcy_l1_rel"
-                                                << ","
-                                                << "err_u_darcy_l2_abs"
-                                                << ","
-                                                << "err_u_darcy_l2_rel"
-                                                << ","
-                                                << "err_u_darcy_linf_abs"
-                                                << ","
-                                                << "err_u_darcy_linf_rel"
-                                                << std::endl;
-                                        }
-
-                                        {
-                                            const std::string resultFilename =
-                                                couplingType + "-errors-p-" +
-                                                monolithicString + "-" +
-                                                caseName + ".csv";
-                                            pressureErrorFile.open(
-                                                resultFilename,
-                                                std::ofstream::trunc);
-
-                                            pressureErrorFile
-                                                << "precice_rel_tol"
-                                                << ","
-                                                << "err_p_stokes_l1_abs"
-                                                << ","
-                                                << "err_stokes_l1_rel"
-                                                << ","
-                                                << "err_p_stokes_l2_abs"
-                                                << ","
-                                                << "err_p_stokes_l2_rel"
-                                                << ","
-                                                << "err_p_stokes_linf_abs"
-                                                << ","
-                                                << "err_p_stokes_linf_rel"
-                                                << ","
-                                                << "err_p_darcy_l1_abs"
-                                                << ","
-                                                << "err_p_darcy_l1_rel"
-                                                << ","
-                                                << "err_p_darcy_l2_abs"
-                                                << ","
-                                                << "err_p_darcy_l2_rel"
-                                                << ","
-                                                << "err_p_darcy_linf_abs"
-                                                << ","
-                                                << "err_p_darcy_linf_rel"
-                                                << std::endl;
-                                        }
-                                    }
-                                    for (const auto &preciceRelTol :
-                                         preciceRelTols) {
-                                        {
-                                            const std::string &iterativeDir =
-                                                iterativeRootDir + "/" +
-                                                couplingType + "/" +
-                                                getIterativeName(
-                                                    equationName, meshSize,
-                                                    alpha, permeability, dp,
-                                                    caseName, preciceRelTol);
-
-                                            std::cout << "Parsing iterative "
-                                                         "data from "
-                                                      << iterativeDir
-                                                      << std::endl;
-                                            const std::string &flowFilename =
-                                                findLastVtu(
-                                                    equationName + "-iterative",
-                                                    iterativeDir);
-                                            std::cout << "Loading monolithic "
-                                                         "free-flow data from: "
-                                                      << std::endl
-                                                      << "  " << flowFilename
-                                                      << std::endl;
-                                            parseData(flowFilename,
-                                                      iterativeData.stokes);
-                                            const std::string &darcyFilename =
-                                                findLastVtu("darcy-iterative",
-                                                            iterativeDir);
-                                            std::cout << "Loading monolithic "
-                                                         "porous-media-flow "
-                                                         "data from: "
-                                                      << std::endl
-                                                      << "  " << darcyFilename
-                                                      << std::endl;
-                                            parseData(darcyFilename,
-                                                      iterativeData.darcy);
-
-                                            AllErrors pressureErrors;
-                                            AllErrors velocityErrors;
-                                            std::tie(pressureErrors,
-                                                     velocityErrors) =
-                                                computeErrors(monolithicData,
-                                                              iterativeData);
-
-                                            pressureErrorFile
-                                                << std::setprecision(
-                                                       outputPrecision)
-                                                << std::scientific;
-                                            pressureErrorFile
-                                                << preciceRelTol << ","
-                                                << pressureErrors.stokes.abs.l1
-                                                << ","
-                                                << pressureErrors.stokes.rel.l1
-                                                << ","
-                                                << pressureErrors.stokes.abs.l2
-                                                << ","
-                                                << pressureErrors.stokes.rel.l2
-                                                << ","
-                                                << pressureErrors.stokes.abs
-                                                       .linf
-                                                << ","
-                                                << pressureErrors.stokes.rel
-                                                       .linf
-                                                << ","
-                                                << pressureErrors.darcy.abs.l1
-                                                << ","
-                                                << pressureErrors.darcy.rel.l1
-                                                << ","
-                                                << pressureErrors.darcy.abs.l2
-                                                << ","
-                                                << pressureErrors.darcy.rel.l2
-                                                << ","
-                                                << pressureErrors.darcy.abs.linf
-                                                << ","
-                                                << pressureErrors.darcy.rel.linf
-                                                << std::endl;
-
-                                            velocityErrorFile
-                                                << std::setprecision(
-                                                       outputPrecision)
-                                                << std::scientific;
-                                            velocityErrorFile
-                                                << preciceRelTol << ","
-                                                << velocityErrors.stokes.abs.l1
-                                                << ","
-                                                << velocityErrors.stokes.rel.l1
-                                                << ","
-                                                << velocityErrors.stokes.abs.l2
-                                                << ","
-                                                << velocityErrors.stokes.rel.l2
-                                                << ","
-                                                << velocityErrors.stokes.abs
-                                                       .linf
-                                                << ","
-                                                << velocityErrors.stokes.rel
-                                                       .linf
-                                                << ","
-                                                << velocityErrors.darcy.abs.l1
-                                                << ","
-                                                << velocityErrors.darcy.rel.l1
-                                                << ","
-                                                << velocityErrors.darcy.abs.l2
-                                                << ","
-                                                << velocityErrors.darcy.rel.l2
-                                                << ","
-                                                << velocityErrors.darcy.abs.linf
-                                                << ","
-                                                << velocityErrors.darcy.rel.linf
-                                                << std::endl;
-                                        }
-                                    }
-                                    velocityErrorFile.close();
-                                    pressureErrorFile.close();
+    // Collect the cases. The monolithic reference of a case does not depend
+    // on the coupling type, the case and the tolerance, so every reference
+    // is only parsed once.
+    std::vector<ReferenceCase> references;
+    std::map<std::string, size_t> referenceIndices;
+    std::vector<ComparisonSeries> series;
+    std::vector<Comparison> comparisons;
+    for (const auto &couplingType : couplingTypes) {
+        for (const auto isNavierStokes : hasInertiaTerms) {
+            const std::string equationName =
+                (isNavierStokes) ? "navier-stokes" : "stokes";
+            for (const auto &meshSize : meshSizes) {
+                for (const auto &alpha : alpha_BJS) {
+                    for (const auto &permeability : permeabilities) {
+                        for (const auto &dp : pressureDifferences) {
+                            const std::string monolithicString =
+                                getMonolithicName(equationName, meshSize,
+                                                  alpha, permeability, dp);
+                            const std::string monolithicDir =
+                                monolithicRootDir + "/" + monolithicString;
+                            const auto inserted = referenceIndices.emplace(
+                                monolithicDir, references.size());
+                            if (inserted.second) {
+                                references.push_back(
+                                    {monolithicDir, equationName, {}});
+                            }
+                            const size_t reference = inserted.first->second;
+
+                            for (const auto &preciceCase : preciceCases) {
+                                const std::string caseName =
+                                    (preciceCase == "serial-implicit")
+                                        ? "stokes-first"
+                                        : "darcy-first";
+                                ComparisonSeries newSeries{
+                                    couplingType,
+                                    monolithicString + "-" + caseName,
+                                    reference,
+                                    {}};
+                                for (const auto &preciceRelTol :
+                                     preciceRelTols) {
+                                    newSeries.comparisons.push_back(
+                                        comparisons.size());
+                                    comparisons.push_back(
+                                        {iterativeRootDir + "/" +
+                                             couplingType + "/" +
+                                             getIterativeName(
+                                                 equationName, meshSize,
+                                                 alpha, permeability, dp,
+                                                 caseName, preciceRelTol),
+                                         equationName,
+                                         preciceRelTol,
+                                         reference,
+                                         {},
+                                         {}});
                                 }
+                                series.push_back(std::move(newSeries));
                             }
                         }
                     }
@@ -696,8 +545,93 @@ int main(int argc, char *argv[])
         }
     }
 
-    //Write file
+    // Index the vtu files of all directories once
+    std::map<std::string, std::vector<std::string> > vtuFiles;
+    for (const auto &reference : references)
+        vtuFiles[reference.directory];
+    for (const auto &comparison : comparisons)
+        vtuFiles[comparison.directory];
     {
+        std::vector<std::map<std::string, std::vector<std::string> >::iterator>
+            directories;
+        for (auto it = vtuFiles.begin(); it != vtuFiles.end(); ++it)
+            directories.push_back(it);
+        parallelFor(directories.size(), numThreads, [&](const size_t i) {
+            directories[i]->second = listVtus(directories[i]->first);
+        });
+    }
+
+    // The log of every case is printed in one piece once the case is done
+    std::mutex logMutex;
+    auto printLog = [&](const std::ostringstream &log) {
+        std::lock_guard<std::mutex> lock(logMutex);
+        std::cout << log.str() << std::flush;
+    };
+
+    // Parse the references
+    parallelFor(references.size(), numThreads, [&](const size_t i) {
+        auto &reference = references[i];
+        const auto &filenames = vtuFiles.at(reference.directory);
+        std::ostringstream log;
+        log << "Parsing monolithic data from " << reference.directory
+            << std::endl;
+        const std::string &flowFilename =
+            findLastVtu("_" + reference.equationName, filenames);
+        log << "Loading monolithic free-flow data from: " << std::endl
+            << "  " << flowFilename << std::endl;
+        parseData(flowFilename, reference.data.stokes, log);
+        const std::string &darcyFilename = findLastVtu("_darcy", filenames);
+        log << "Loading monolithic porous-media-flow data from: " << std::endl
+            << "  " << darcyFilename << std::endl;
+        parseData(darcyFilename, reference.data.darcy, log);
+        printLog(log);
+    });
+
+    // Compare the iterative solutions, the parsed data of a case is
+    // released as soon as its errors are computed
+    parallelFor(comparisons.size(), numThreads, [&](const size_t i) {
+        auto &comparison = comparisons[i];
+        const auto &filenames = vtuFiles.at(comparison.directory);
+        std::ostringstream log;
+        log << "Parsing iterative data from " << comparison.directory
+            << std::endl;
+        ParsedData iterativeData;
+        const std::string &flowFilename =
+            findLastVtu(comparison.equationName + "-iterative", filenames);
+        log << "Loading iterative free-flow data from: " << std::endl
+            << "  " << flowFilename << std::endl;
+        parseData(flowFilename, iterativeData.stokes, log);
+        const std::string &darcyFilename =
+            findLastVtu("darcy-iterative", filenames);
+        log << "Loading iterative porous-media-flow data from: " << std::endl
+            << "  " << darcyFilename << std::endl;
+        parseData(darcyFilename, iterativeData.darcy, log);
+
+        std::tie(comparison.pressureErrors, comparison.velocityErrors) =
+            computeErrors(references[comparison.reference].data,
+                          iterativeData, log);
+        printLog(log);
+    });
+
+    //Write file
+    for (const auto &resultSeries : series) {
+        std::ofstream velocityErrorFile(resultSeries.couplingType +
+                                            "-errors-u-" +
+                                            resultSeries.resultName + ".csv",
+                                        std::ofstream::trunc);
+        std::ofstream pressureErrorFile(resultSeries.couplingType +
+                                            "-errors-p-" +
+                                            resultSeries.resultName + ".csv",
+                                        std::ofstream::trunc);
+        writeErrorHeader(velocityErrorFile, "u");
+        writeErrorHeader(pressureErrorFile, "p");
+        for (const auto c : resultSeries.comparisons) {
+            const auto &comparison = comparisons[c];
+            writeErrorRow(pressureErrorFile, comparison.preciceRelTol,
+                          comparison.pressureErrors);
+            writeErrorRow(velocityErrorFile, comparison.preciceRelTol,
+                          comparison.velocityErrors);
+        }
     }
 
     return EXIT_SUCCESS;
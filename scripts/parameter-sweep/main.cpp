@@ -0,0 +1,473 @@
+// Runs a parameter sweep of a coupled free-flow/porous-medium simulation.
+//
+// Usage: parameter_sweep <sweep file> [number of concurrent cases]
+//
+// The sweep file lists the solvers, the templates of the input file and of
+// the preCICE configuration, and the values of the placeholders in the
+// templates:
+//
+//   FreeFlowSolver = ./ff_flow_over_square_2d
+//   DarcySolver = ./pm_flow_over_square_2d
+//   InputTemplate = base.input
+//   PreciceConfigTemplates = base-implicit.xml base-implicit-darcy-first.xml
+//   TargetDirectory = implicit
+//   Placeholder.MESHSIZE = 20 40
+//   Placeholder.RELTOL = 1e-2 1e-4
+//   Placeholder.HASINERTIATERMS,FLOWPROBLEMNAME = true,navier-stokes false,stokes
+//
+// Every combination of the placeholder values and the preCICE templates is
+// a case. Placeholders separated by commas vary together. The case is named
+// like in run-iterative-parallel-simulations.sh and in the comparison of
+// postprocessing/vtk, <FLOWPROBLEMNAME>-<RELTOL>-<MESHSIZE>-<ALPHA>-<PERM>-
+// <PRESSUREDIFF>, followed by -darcy-first if the name of the preCICE
+// template contains darcy-first. The placeholders and CASENAME are replaced
+// in both templates and every case runs in its own directory below
+// TargetDirectory, so that independent cases run concurrently without
+// sharing preCICE's exchange files. The number of iterations and time
+// windows are taken from the statistics the solvers write
+// (preCICE.StatisticsFileName) and collected in
+// TargetDirectory/sweep-results.csv.
+//
+// Like the script, the tool starts both solvers as separate processes for
+// every case, it does not reuse the grid or the interface between cases.
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <set>
+#include <vector>
+#include "boost/filesystem.hpp"
+#include "casenames.hh"
+using namespace boost::filesystem;
+
+// placeholders that vary together and their values
+struct Placeholder {
+    std::vector<std::string> names;
+    std::vector<std::vector<std::string> > values;
+};
+
+// the description of a sweep
+struct Sweep {
+    std::string freeFlowSolver;
+    std::string darcySolver;
+    std::string inputTemplate;
+    std::vector<std::string> preciceConfigTemplates;
+    std::string targetDirectory = "sweep";
+    std::vector<Placeholder> placeholders;
+};
+
+// one combination of placeholder values
+struct Case {
+    std::string name;
+    std::string preciceConfigTemplate;
+    std::vector<std::pair<std::string, std::string> > values;
+};
+
+// the outcome of one case
+struct CaseResult {
+    int freeFlowStatus = -1;
+    int darcyStatus = -1;
+    double wallTime = 0.;
+    long long freeFlowIterations = -1;
+    long long darcyIterations = -1;
+    long long timeWindows = -1;
+};
+
+std::string trim(const std::string &s)
+{
+    const auto begin = s.find_first_not_of(" \t\r");
+    if (begin == std::string::npos)
+        return "";
+    const auto end = s.find_last_not_of(" \t\r");
+    return s.substr(begin, end - begin + 1);
+}
+
+std::vector<std::string> splitWords(const std::string &s)
+{
+    std::istringstream iss(s);
+    std::vector<std::string> words;
+    for (std::string word; iss >> word;)
+        words.push_back(word);
+    return words;
+}
+
+std::vector<std::string> splitCommas(const std::string &s)
+{
+    std::istringstream iss(s);
+    std::vector<std::string> parts;
+    for (std::string part; std::getline(iss, part, ',');)
+        parts.push_back(trim(part));
+    return parts;
+}
+
+std::string readFile(const std::string &fileName)
+{
+    std::ifstream ifs(fileName);
+    if (!ifs)
+        throw std::runtime_error("Cannot read " + fileName);
+    std::ostringstream oss;
+    oss << ifs.rdbuf();
+    return oss.str();
+}
+
+void writeFile(const std::string &fileName, const std::string &content)
+{
+    std::ofstream ofs(fileName, std::ofstream::out | std::ofstream::trunc);
+    ofs << content;
+    if (!ofs)
+        throw std::runtime_error("Cannot write " + fileName);
+}
+
+Sweep readSweep(const std::string &fileName)
+{
+    Sweep sweep;
+    std::istringstream iss(readFile(fileName));
+    const std::string placeholderPrefix = "Placeholder.";
+    for (std::string line; std::getline(iss, line);) {
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty())
+            continue;
+        const auto equals = line.find('=');
+        if (equals == std::string::npos)
+            throw std::runtime_error("Invalid line in " + fileName + ": " +
+                                     line);
+        const std::string key = trim(line.substr(0, equals));
+        const std::string value = trim(line.substr(equals + 1));
+        if (key == "FreeFlowSolver")
+            sweep.freeFlowSolver = absolute(value).string();
+        else if (key == "DarcySolver")
+            sweep.darcySolver = absolute(value).string();
+        else if (key == "InputTemplate")
+            sweep.inputTemplate = value;
+        else if (key == "PreciceConfigTemplates")
+            sweep.preciceConfigTemplates = splitWords(value);
+        else if (key == "TargetDirectory")
+            sweep.targetDirectory = value;
+        else if (key.compare(0, placeholderPrefix.size(), placeholderPrefix) ==
+                 0) {
+            Placeholder placeholder;
+            placeholder.names = splitCommas(key.substr(placeholderPrefix.size()));
+            for (const auto &word : splitWords(value)) {
+                placeholder.values.push_back(splitCommas(word));
+                if (placeholder.values.back().size() != placeholder.names.size())
+                    throw std::runtime_error("Wrong number of values for " +
+                                             key + ": " + word);
+            }
+            if (placeholder.values.empty())
+                throw std::runtime_error("No values for " + key);
+            sweep.placeholders.push_back(placeholder);
+        } else
+            throw std::runtime_error("Unknown key in " + fileName + ": " + key);
+    }
+
+    if (sweep.freeFlowSolver.empty() || sweep.darcySolver.empty() ||
+        sweep.inputTemplate.empty() || sweep.preciceConfigTemplates.empty())
+        throw std::runtime_error(
+            fileName +
+            " needs FreeFlowSolver, DarcySolver, InputTemplate and "
+            "PreciceConfigTemplates");
+    return sweep;
+}
+
+// the name of a case, the directory the comparison of postprocessing/vtk
+// looks for
+std::string makeCaseName(const Case &c)
+{
+    auto value = [&c](const std::string &name) -> std::string {
+        for (const auto &v : c.values)
+            if (v.first == name)
+                return v.second;
+        throw std::runtime_error("The case name needs the placeholder " +
+                                 name);
+    };
+    const std::string order =
+        path(c.preciceConfigTemplate).filename().string().find(
+            "darcy-first") != std::string::npos
+            ? "darcy-first"
+            : "stokes-first";
+    return getIterativeName(value("FLOWPROBLEMNAME"), value("MESHSIZE"),
+                            value("ALPHA"), value("PERM"),
+                            value("PRESSUREDIFF"), order, value("RELTOL"));
+}
+
+// all combinations of the placeholder values and the preCICE templates
+std::vector<Case> makeCases(const Sweep &sweep)
+{
+    std::vector<Case> cases;
+    std::set<std::string> names;
+    std::vector<size_t> index(sweep.placeholders.size(), 0);
+    for (const auto &preciceTemplate : sweep.preciceConfigTemplates) {
+        std::fill(index.begin(), index.end(), 0);
+        for (bool done = false; !done;) {
+            Case c;
+            c.preciceConfigTemplate = preciceTemplate;
+            for (size_t p = 0; p < index.size(); ++p) {
+                const auto &placeholder = sweep.placeholders[p];
+                const auto &values = placeholder.values[index[p]];
+                for (size_t n = 0; n < values.size(); ++n)
+                    c.values.emplace_back(placeholder.names[n], values[n]);
+            }
+            c.name = makeCaseName(c);
+            // cases of the same name would run in the same directory
+            if (!names.insert(c.name).second)
+                throw std::runtime_error("Two cases are named " + c.name);
+            c.values.emplace_back("CASENAME", c.name);
+            cases.push_back(c);
+
+            // next combination, the last placeholder varies fastest
+            done = true;
+            for (size_t p = index.size(); p-- > 0;) {
+                if (++index[p] < sweep.placeholders[p].values.size()) {
+                    done = false;
+                    break;
+                }
+                index[p] = 0;
+            }
+        }
+    }
+    return cases;
+}
+
+std::string substitute(
+    std::string text,
+    const std::vector<std::pair<std::string, std::string> > &values)
+{
+    for (const auto &value : values)
+        for (auto pos = text.find(value.first); pos != std::string::npos;
+             pos = text.find(value.first, pos + value.second.size()))
+            text.replace(pos, value.first.size(), value.second);
+    return text;
+}
+
+// starts a process in the given directory with its output going to logFile
+pid_t startProcess(const std::vector<std::string> &args,
+                   const std::string &directory,
+                   const std::string &logFile)
+{
+    // no allocations after fork, other threads may hold the allocator's lock
+    std::vector<char *> argv;
+    for (const auto &arg : args)
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    argv.push_back(nullptr);
+
+    const pid_t pid = fork();
+    if (pid < 0)
+        throw std::runtime_error("Cannot start " + args[0]);
+    if (pid == 0) {
+        const int fd =
+            open(logFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (chdir(directory.c_str()) != 0 || fd < 0)
+            _exit(127);
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        close(fd);
+        execv(argv[0], argv.data());
+        _exit(127);
+    }
+    return pid;
+}
+
+int waitForProcess(const pid_t pid)
+{
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid)
+        return -1;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+// the value of the first "key": <number> in a statistics file
+long long findCount(const std::string &json,
+                    const std::string &key,
+                    const size_t from = 0)
+{
+    const auto pos = json.find("\"" + key + "\":", from);
+    if (pos == std::string::npos)
+        return -1;
+    return std::atoll(json.c_str() + pos + key.size() + 3);
+}
+
+// reads the number of iterations and time windows of one participant
+void readStatistics(const std::string &fileName,
+                    long long &iterations,
+                    long long &timeWindows)
+{
+    if (!exists(fileName))
+        return;
+    const std::string json = readFile(fileName);
+    iterations = findCount(json, "iterations");
+    const auto windows = json.find("\"timeWindows\":");
+    if (windows == std::string::npos)
+        return;
+    timeWindows = 0;
+    for (auto pos = json.find("{\"iterations\"", windows);
+         pos != std::string::npos; pos = json.find("{\"iterations\"", pos + 1))
+        ++timeWindows;
+}
+
+CaseResult runCase(const Sweep &sweep,
+                   const Case &c,
+                   const std::string &inputTemplate)
+{
+    const path directory = absolute(path(sweep.targetDirectory) / c.name);
+    create_directories(directory);
+    const std::string inputFile = (directory / (c.name + ".input")).string();
+    const std::string preciceConfig = (directory / (c.name + ".xml")).string();
+    writeFile(inputFile, substitute(inputTemplate, c.values));
+    writeFile(preciceConfig,
+              substitute(readFile(c.preciceConfigTemplate), c.values));
+    // leftovers of an earlier sweep would be taken for this one's: preCICE
+    // connects through the exchange files in precice-run and the statistics
+    // of a solver that fails early would be read
+    remove_all(directory / "precice-run");
+    remove(directory / "freeflow-statistics.json");
+    remove(directory / "darcy-statistics.json");
+
+    auto args = [&](const std::string &solver, const std::string &name) {
+        return std::vector<std::string>{solver,
+                                        inputFile,
+                                        "-preCICE.StatisticsFileName",
+                                        name + "-statistics.json",
+                                        "-",
+                                        preciceConfig};
+    };
+
+    CaseResult result;
+    const auto start = std::chrono::steady_clock::now();
+    const pid_t freeFlow =
+        startProcess(args(sweep.freeFlowSolver, "freeflow"), directory.string(),
+                     (directory / "freeflow.log").string());
+    pid_t darcy;
+    try {
+        darcy =
+            startProcess(args(sweep.darcySolver, "darcy"), directory.string(),
+                         (directory / "darcy.log").string());
+    } catch (...) {
+        // the free-flow solver would wait for its partner forever
+        kill(freeFlow, SIGKILL);
+        waitForProcess(freeFlow);
+        throw;
+    }
+    result.freeFlowStatus = waitForProcess(freeFlow);
+    result.darcyStatus = waitForProcess(darcy);
+    result.wallTime = std::chrono::duration<double>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+
+    readStatistics((directory / "freeflow-statistics.json").string(),
+                   result.freeFlowIterations, result.timeWindows);
+    long long darcyTimeWindows = -1;
+    readStatistics((directory / "darcy-statistics.json").string(),
+                   result.darcyIterations, darcyTimeWindows);
+    if (result.timeWindows < 0)
+        result.timeWindows = darcyTimeWindows;
+    return result;
+}
+
+void writeResults(const std::string &fileName,
+                  const Sweep &sweep,
+                  const std::vector<Case> &cases,
+                  const std::vector<CaseResult> &results)
+{
+    std::ofstream ofs(fileName, std::ofstream::out | std::ofstream::trunc);
+    ofs << "case,preciceConfig";
+    for (const auto &placeholder : sweep.placeholders)
+        for (const auto &name : placeholder.names)
+            ofs << "," << name;
+    ofs << ",freeFlowStatus,darcyStatus,wallTime,freeFlowIterations,"
+           "darcyIterations,timeWindows\n";
+    for (size_t i = 0; i < cases.size(); ++i) {
+        ofs << cases[i].name << "," << cases[i].preciceConfigTemplate;
+        // the last value is the case name
+        for (size_t v = 0; v + 1 < cases[i].values.size(); ++v)
+            ofs << "," << cases[i].values[v].second;
+        const auto &r = results[i];
+        ofs << "," << r.freeFlowStatus << "," << r.darcyStatus << ","
+            << std::setprecision(6) << r.wallTime << ","
+            << r.freeFlowIterations << "," << r.darcyIterations << ","
+            << r.timeWindows << "\n";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <sweep file> [number of concurrent cases]" << std::endl;
+        return 1;
+    }
+
+    try {
+        const Sweep sweep = readSweep(argv[1]);
+        const auto cases = makeCases(sweep);
+        const std::string inputTemplate = readFile(sweep.inputTemplate);
+
+        // every case runs two solvers
+        unsigned numThreads =
+            std::max(1u, std::thread::hardware_concurrency() / 2);
+        if (argc == 3)
+            numThreads = std::max(1, std::atoi(argv[2]));
+        std::cout << "Running " << cases.size() << " cases, " << numThreads
+                  << " at a time" << std::endl;
+
+        std::vector<CaseResult> results(cases.size());
+        std::atomic<size_t> next(0);
+        std::mutex logMutex;
+        std::exception_ptr error;
+        auto worker = [&]() {
+            for (size_t i = next++; i < cases.size(); i = next++) {
+                try {
+                    results[i] = runCase(sweep, cases[i], inputTemplate);
+                    std::lock_guard<std::mutex> lock(logMutex);
+                    const bool failed = results[i].freeFlowStatus != 0 ||
+                                        results[i].darcyStatus != 0;
+                    std::cout << (failed ? "FAILED " : "done   ")
+                              << cases[i].name << " (" << results[i].wallTime
+                              << " s)" << std::endl;
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(logMutex);
+                    if (!error)
+                        error = std::current_exception();
+                }
+            }
+        };
+        std::vector<std::thread> threads;
+        for (unsigned t = 1; t < numThreads; ++t)
+            threads.emplace_back(worker);
+        worker();
+        for (auto &thread : threads)
+            thread.join();
+        if (error)
+            std::rethrow_exception(error);
+
+        const std::string resultFile =
+            (path(sweep.targetDirectory) / "sweep-results.csv").string();
+        writeResults(resultFile, sweep, cases, results);
+        std::cout << "In total " << cases.size()
+                  << " cases were run, results in " << resultFile << std::endl;
+
+        const bool anyFailed =
+            std::any_of(results.begin(), results.end(), [](const auto &r) {
+                return r.freeFlowStatus != 0 || r.darcyStatus != 0;
+            });
+        return anyFailed ? 2 : 0;
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,72 @@
+/*!
+ * @brief Unit tests of the cell matching of the postprocessing tools.
+ */
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "postprocessing/cellmatching.hh"
+
+namespace
+{
+/*!
+ * @brief Throws if a condition of a test does not hold.
+ *
+ * @param[in] condition The condition.
+ * @param[in] message Description of the condition.
+ */
+void check(const bool condition, const std::string &message)
+{
+    if (!condition)
+        throw std::runtime_error("Check failed: " + message);
+}
+
+void testTolerance()
+{
+    check(cellCenterTolerance({{0., 0., 0.}, {0., 0., 0.}}, 1e-6) == 1e-12,
+          "lower bound if all coordinates are zero");
+    check(cellCenterTolerance({{0., -4., 0.}, {2., 0., 0.}}, 1e-6) == 4e-6,
+          "relative to the largest coordinate");
+}
+
+void testMatching()
+{
+    const std::vector<std::array<double, 3> > reference = {
+        {0.5, 0.5, 0.}, {1.5, 0.5, 0.}, {0.5, 1.5, 0.}, {1.5, 1.5, 0.}};
+    // Permuted, and the match of the first reference cell lies in a
+    // neighbouring cell of the hash grid
+    const double tolerance = 1e-3;
+    const std::vector<std::array<double, 3> > data = {{1.5, 1.5, 0.},
+                                                      {0.5 - 0.5e-3, 0.5, 0.},
+                                                      {1.5, 0.5, 0.},
+                                                      {0.5, 1.5, 0.}};
+    const auto matches = matchCellCenters(reference, data, tolerance);
+    check(matches == std::vector<std::size_t>({1, 2, 3, 0}), "permutation");
+
+    bool threw = false;
+    try {
+        matchCellCenters(reference, {{0., 0., 0.}, {1.5, 0.5, 0.},
+                                     {0.5, 1.5, 0.}, {1.5, 1.5, 0.}},
+                         tolerance);
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    check(threw, "cell without match");
+}
+}  // namespace
+
+int main()
+{
+    try {
+        testTolerance();
+        testMatching();
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,590 @@
+/*!
+ * @brief Unit tests of the coupling adapter.
+ *
+ * The adapter is linked against the stand-in for preCICE's SolverInterface
+ * of the benchmarks (benchmarks/mocksolverinterface.cc). Data written to
+ * preCICE is kept by the stand-in and returned by the next read, so a
+ * single participant can check the round trip through the adapter.
+ */
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+
+#include "dumux-precice/couplingadapter.hh"
+
+namespace
+{
+using Dumux::Precice::CouplingAdapter;
+using Dumux::Precice::QuantityType;
+using Dumux::Precice::ScalarQuantityHandle;
+using Dumux::Precice::VectorQuantityHandle;
+using Dumux::Precice::VertexOrdering;
+
+/*!
+ * @brief Throws if a condition of a test does not hold.
+ *
+ * @param[in] condition The condition.
+ * @param[in] message Description of the condition.
+ */
+void check(const bool condition, const std::string &message)
+{
+    if (!condition)
+        throw std::runtime_error("Check failed: " + message);
+}
+
+/*!
+ * @brief Creates the coordinates of points on a line.
+ *
+ * @param[in] dim Number of spatial dimensions.
+ * @param[in] xs First coordinate of the points, all others are zero.
+ * @return std::vector<double> Coordinates stored consecutively.
+ */
+std::vector<double> pointsOnLine(const int dim, const std::vector<double> &xs)
+{
+    std::vector<double> coordinates(xs.size() * dim, 0.);
+    for (std::size_t i = 0; i < xs.size(); ++i)
+        coordinates[i * dim] = xs[i];
+    return coordinates;
+}
+
+/*!
+ * @brief Coupling adapter with one mesh of four faces.
+ *
+ * The adapter is set up in the order of the drivers: the quantities are
+ * announced after initialize.
+ */
+struct Setup {
+    Setup()
+    {
+        adapter.announceSolver("Test", "precice-config.xml", 0, 1);
+        auto coordinates =
+            pointsOnLine(adapter.getDimensions(), {0., 1., 2., 3.});
+        meshIndex = adapter.setMesh("TestMesh", 4, coordinates);
+        adapter.createIndexMapping(meshIndex, faceIDs);
+        adapter.initialize();
+        pressureId = adapter.announceScalarQuantity(meshIndex, "Pressure");
+    }
+
+    CouplingAdapter adapter;
+    const std::vector<int> faceIDs = {12, 4, 8, 0};
+    std::size_t meshIndex;
+    std::size_t pressureId;
+};
+
+void testIndexMapping()
+{
+    Setup s;
+    for (std::size_t i = 0; i < s.faceIDs.size(); ++i)
+        s.adapter.writeScalarQuantityOnFace(s.pressureId, s.faceIDs[i],
+                                            double(i + 1));
+    for (std::size_t i = 0; i < s.faceIDs.size(); ++i)
+        check(s.adapter.getScalarQuantityOnFace(s.pressureId, s.faceIDs[i]) ==
+                  double(i + 1),
+              "value of face " + std::to_string(s.faceIDs[i]));
+    // preCICE gets the values in the order of the vertices
+    check(s.adapter.getQuantityVector(s.pressureId) ==
+              std::vector<double>({1., 2., 3., 4.}),
+          "vertex order");
+    check(s.adapter.isCoupledEntity(8) && !s.adapter.isCoupledEntity(5) &&
+              !s.adapter.isCoupledEntity(13),
+          "coupled faces");
+}
+
+void testBulkIO()
+{
+    Setup s;
+    s.adapter.writeQuantityOnFaces(s.pressureId, {1., 2., 3., 4.});
+    for (std::size_t i = 0; i < s.faceIDs.size(); ++i)
+        check(s.adapter.getScalarQuantityOnFace(s.pressureId, s.faceIDs[i]) ==
+                  double(i + 1),
+              "value of face " + std::to_string(s.faceIDs[i]));
+
+    std::vector<double> values;
+    s.adapter.readQuantityOnFaces(s.pressureId, {0, 12}, values);
+    check(values == std::vector<double>({4., 1.}), "values of some faces");
+    s.adapter.writeQuantityOnFaces(s.pressureId, {8}, {7.});
+    check(s.adapter.getScalarQuantityOnFace(s.pressureId, 8) == 7.,
+          "write to some faces");
+
+    // The values go through preCICE and are read back
+    s.adapter.writeQuantityToOtherSolver(s.pressureId, QuantityType::Scalar);
+    s.adapter.writeQuantityOnFaces(s.pressureId, {0., 0., 0., 0.});
+    s.adapter.readQuantityFromOtherSolver(s.pressureId, QuantityType::Scalar);
+    s.adapter.readQuantityOnFaces(s.pressureId, values);
+    check(values == std::vector<double>({1., 2., 7., 4.}), "round trip");
+}
+
+void testBoundBuffer()
+{
+    Setup s;
+    // The bound buffer is the storage of the quantity
+    std::vector<double> buffer = {1., 2., 3., 4.};
+    s.adapter.bindQuantityBuffer(s.pressureId, buffer.data(), buffer.size());
+    check(s.adapter.hasExternalBuffer(s.pressureId) &&
+              s.adapter.getScalarQuantityOnFace(s.pressureId, 4) == 2.,
+          "values of the bound buffer");
+    s.adapter.writeScalarQuantityOnFace(s.pressureId, 8, 5.);
+    check(buffer[2] == 5., "write into the bound buffer");
+
+    // preCICE reads into the bound buffer
+    s.adapter.writeQuantityToOtherSolver(s.pressureId, QuantityType::Scalar);
+    buffer[2] = 0.;
+    s.adapter.readQuantityFromOtherSolver(s.pressureId, QuantityType::Scalar);
+    check(buffer[2] == 5., "read into the bound buffer");
+
+    s.adapter.unbindQuantityBuffer(s.pressureId);
+    check(!s.adapter.hasExternalBuffer(s.pressureId) &&
+              s.adapter.getScalarQuantityOnFace(s.pressureId, 8) == 5.,
+          "values copied back after unbinding");
+
+    bool threw = false;
+    try {
+        s.adapter.bindQuantityBuffer(s.pressureId, buffer.data(), 3);
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    check(threw, "buffer of the wrong size");
+}
+
+void testVectorQuantity()
+{
+    Setup s;
+    constexpr int dim = 3;
+    check(s.adapter.getDimensions() == dim, "dimensions of the stand-in");
+    const auto velocityId =
+        s.adapter.announceVectorQuantity(s.meshIndex, "Velocity");
+    using Vector = Dune::FieldVector<double, dim>;
+
+    s.adapter.writeVectorQuantityOnFace<dim>(velocityId, 8,
+                                             Vector({1., 2., 3.}));
+    check(s.adapter.getVectorQuantityOnFace<dim>(velocityId, 8) ==
+              Vector({1., 2., 3.}),
+          "value of a face");
+    // The components of a vertex are interleaved
+    const auto &data = s.adapter.getQuantityVector(velocityId);
+    check(data.size() == 4 * dim && data[2 * dim] == 1. &&
+              data[2 * dim + 2] == 3.,
+          "interleaved components");
+
+    s.adapter.writeVectorQuantityOnFaces<dim>(
+        velocityId, {0, 12}, {Vector({4., 5., 6.}), Vector({7., 8., 9.})});
+    std::vector<Vector> values;
+    s.adapter.readVectorQuantityOnFaces<dim>(velocityId, {12, 8, 0}, values);
+    check(values == std::vector<Vector>({Vector({7., 8., 9.}),
+                                         Vector({1., 2., 3.}),
+                                         Vector({4., 5., 6.})}),
+          "values of some faces");
+}
+
+void testMultipleMeshes()
+{
+    CouplingAdapter adapter;
+    adapter.announceSolver("Test", "precice-config.xml", 0, 1);
+    const int dim = adapter.getDimensions();
+    auto first = pointsOnLine(dim, {0., 1.});
+    auto second = pointsOnLine(dim, {2., 3., 4.});
+    const auto firstMesh = adapter.setMesh("FirstMesh", 2, first);
+    const auto secondMesh = adapter.setMesh("SecondMesh", 3, second);
+    adapter.createIndexMapping(firstMesh, {0, 1});
+    adapter.createIndexMapping(secondMesh, {1, 2, 3});
+    adapter.initialize();
+    check(adapter.getNumberOfMeshes() == 2 &&
+              adapter.getNumberOfVertices(secondMesh) == 3,
+          "meshes");
+    check(adapter.isCoupledEntity(firstMesh, 0) &&
+              !adapter.isCoupledEntity(secondMesh, 0),
+          "coupled faces of a mesh");
+
+    // Announced on the second mesh first, the first mesh still wins
+    const auto onSecond =
+        adapter.announceScalarQuantity(secondMesh, "Velocity");
+    const auto onFirst = adapter.announceScalarQuantity(firstMesh, "Velocity");
+    check(adapter.getIdFromName("Velocity") == onFirst, "lowest mesh");
+    check(adapter.getIdFromName(secondMesh, "Velocity") == onSecond,
+          "quantity on the given mesh");
+
+    // Face 1 is on both meshes, every quantity uses the faces of its mesh
+    adapter.writeScalarQuantityOnFace(onFirst, 1, 3.);
+    adapter.writeScalarQuantityOnFace(onSecond, 1, 5.);
+    check(adapter.getScalarQuantityOnFace(onFirst, 1) == 3. &&
+              adapter.getScalarQuantityOnFace(onSecond, 1) == 5.,
+          "values of the meshes");
+    check(adapter.getQuantityVector(onSecond).size() == 3,
+          "size of a quantity");
+
+    bool threw = false;
+    try {
+        adapter.announceScalarQuantity(secondMesh, "Pressure");
+        adapter.getIdFromName(firstMesh, "Pressure");
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    check(threw, "quantity not on the given mesh");
+}
+
+void testChangeTracking()
+{
+    Setup s;
+    s.adapter.enableChangeTracking(s.pressureId);
+    s.adapter.writeQuantityOnFaces(s.pressureId, {1., 1., 1., 1.});
+    s.adapter.writeQuantityToOtherSolver(s.pressureId, QuantityType::Scalar);
+
+    const double inf = std::numeric_limits<double>::infinity();
+    s.adapter.readQuantityFromOtherSolver(s.pressureId, QuantityType::Scalar);
+    check(s.adapter.getQuantityChangeNorm(s.pressureId) == inf, "first read");
+
+    // The buffer of a read quantity holds the data of the last read, the
+    // new data only reaches preCICE
+    s.adapter.writeQuantityOnFaces(s.pressureId, {1., 1., 1., 3.});
+    s.adapter.writeQuantityToOtherSolver(s.pressureId, QuantityType::Scalar);
+    s.adapter.writeQuantityOnFaces(s.pressureId, {1., 1., 1., 1.});
+    s.adapter.readQuantityFromOtherSolver(s.pressureId, QuantityType::Scalar);
+    check(s.adapter.getQuantityChangeNorm(s.pressureId) == 2., "second read");
+    check(s.adapter.getRelativeQuantityChange(s.pressureId) ==
+              2. / std::sqrt(12.),
+          "relative change");
+
+    check(s.adapter.getRelativeQuantityChange(s.pressureId,
+                                              {1., 1., 1., 3.}) == 0.,
+          "no change since the given data");
+    check(s.adapter.getRelativeQuantityChange(s.pressureId, {1., 1.}) == inf,
+          "reference of the wrong size");
+}
+
+void testMortonOrdering()
+{
+    CouplingAdapter adapter;
+    adapter.announceSolver("Test", "precice-config.xml", 0, 1);
+    auto coordinates =
+        pointsOnLine(adapter.getDimensions(), {3., 0., 2., 1.});
+    const auto meshIndex = adapter.setMesh("TestMesh", 4, coordinates,
+                                           VertexOrdering::Morton);
+    adapter.createIndexMapping(meshIndex, {30, 0, 20, 10});
+    adapter.initialize();
+    const auto pressureId =
+        adapter.announceScalarQuantity(meshIndex, "Pressure");
+
+    // The reordering is hidden, values stay in the order of the points
+    adapter.writeQuantityOnFaces(pressureId, {4., 1., 3., 2.});
+    std::vector<double> values;
+    adapter.readQuantityOnFaces(pressureId, values);
+    check(values == std::vector<double>({4., 1., 3., 2.}), "face order");
+    check(adapter.getScalarQuantityOnFace(pressureId, 20) == 3.,
+          "value of a face");
+    // preCICE gets the vertices along the curve, i.e. sorted by x
+    check(adapter.getQuantityVector(pressureId) ==
+              std::vector<double>({1., 2., 3., 4.}),
+          "vertex order");
+}
+
+void testDeduplication()
+{
+    CouplingAdapter adapter;
+    adapter.announceSolver("Test", "precice-config.xml", 0, 1);
+    const int dim = adapter.getDimensions();
+    // The second and third point are closer than the tolerance, but x /
+    // tolerance rounds to 0 for one and to 1 for the other. They are hashed
+    // into neighbouring cells of the hash grid.
+    const double tolerance = 1e-12;
+    auto coordinates =
+        pointsOnLine(dim, {-1., 0.5e-12 - 1e-13, 0.5e-12 + 1e-13, 1.});
+    const auto meshIndex =
+        adapter.setMesh("TestMesh", 4, coordinates, VertexOrdering::Morton,
+                        true, tolerance);
+    adapter.createIndexMapping(meshIndex, {0, 1, 2, 3});
+    adapter.initialize();
+    const auto pressureId =
+        adapter.announceScalarQuantity(meshIndex, "Pressure");
+
+    check(adapter.getNumberOfVertices(meshIndex) == 3, "merged vertices");
+    adapter.writeScalarQuantityOnFace(pressureId, 1, 7.);
+    check(adapter.getScalarQuantityOnFace(pressureId, 2) == 7.,
+          "faces sharing a vertex share the value");
+    adapter.writeScalarQuantityOnFace(pressureId, 3, 9.);
+    check(adapter.getScalarQuantityOnFace(pressureId, 0) != 9.,
+          "distinct points keep their values");
+}
+
+void testQuantityHandles()
+{
+    Setup s;
+    const auto force = s.adapter.announceVectorQuantity(s.meshIndex, "Force");
+    static_assert(
+        std::is_same<decltype(force), const VectorQuantityHandle>::value,
+        "vector quantities are announced with a vector handle");
+    check(s.adapter.getIdFromName("Force") == force.id() &&
+              s.adapter.getIdFromName("Pressure") == s.pressureId,
+          "identifiers of the handles");
+    check(s.adapter.getHandleFromName<QuantityType::Vector>("Force") == force,
+          "typed handle");
+    check(s.adapter.getHandleFromName<QuantityType::Scalar>(s.meshIndex,
+                                                            "Pressure") ==
+              s.pressureId,
+          "typed handle on the given mesh");
+
+    // The type of the handle selects the type of the exchange
+    const ScalarQuantityHandle pressure(s.pressureId);
+    s.adapter.writeQuantityOnFaces(pressure, {1., 2., 3., 4.});
+    s.adapter.writeQuantityToOtherSolver(pressure);
+    s.adapter.writeQuantityOnFaces(pressure, {0., 0., 0., 0.});
+    s.adapter.readQuantityFromOtherSolver(pressure);
+    check(s.adapter.getScalarQuantityOnFace(pressure, 8) == 3., "round trip");
+
+    bool threw = false;
+    try {
+        s.adapter.getHandleFromName<QuantityType::Scalar>("Force");
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    check(threw, "handle of the wrong type");
+    threw = false;
+    try {
+        s.adapter.getIdFromName("Temperature");
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    check(threw, "unknown quantity");
+}
+
+void testBatchedIO()
+{
+    CouplingAdapter adapter;
+    adapter.announceSolver("Test", "precice-config.xml", 0, 1);
+    const int dim = adapter.getDimensions();
+    auto first = pointsOnLine(dim, {0., 1.});
+    auto second = pointsOnLine(dim, {2., 3., 4.});
+    const auto firstMesh = adapter.setMesh("FirstMesh", 2, first);
+    const auto secondMesh = adapter.setMesh("SecondMesh", 3, second);
+    adapter.createIndexMapping(firstMesh, {0, 1});
+    adapter.createIndexMapping(secondMesh, {2, 3, 4});
+    adapter.initialize();
+    const auto pressure =
+        adapter.announceScalarQuantity(secondMesh, "Pressure");
+    const auto velocity =
+        adapter.announceVectorQuantity(firstMesh, "Velocity");
+    const auto temperature =
+        adapter.announceScalarQuantity(firstMesh, "Temperature");
+
+    // The quantities are on interleaved meshes and of different types
+    adapter.writeQuantityOnFaces(pressure, {1., 2., 3.});
+    adapter.writeQuantityOnFaces(velocity, std::vector<double>(2 * dim, 4.));
+    adapter.writeQuantityOnFaces(temperature, {5., 6.});
+    adapter.writeQuantitiesToOtherSolver({pressure, velocity, temperature});
+    adapter.writeQuantityOnFaces(pressure, {0., 0., 0.});
+    adapter.writeQuantityOnFaces(velocity, std::vector<double>(2 * dim, 0.));
+    adapter.writeQuantityOnFaces(temperature, {0., 0.});
+    adapter.readQuantitiesFromOtherSolver({pressure, velocity, temperature});
+
+    std::vector<double> values;
+    adapter.readQuantityOnFaces(pressure, values);
+    check(values == std::vector<double>({1., 2., 3.}), "scalar quantity");
+    adapter.readQuantityOnFaces(velocity, values);
+    check(values == std::vector<double>(2 * dim, 4.), "vector quantity");
+    adapter.readQuantityOnFaces(temperature, values);
+    check(values == std::vector<double>({5., 6.}),
+          "second quantity of a mesh");
+}
+
+void testTimeInterpolation()
+{
+    Setup s;
+    constexpr int dim = 3;
+    using Vector = Dune::FieldVector<double, dim>;
+    const auto velocityId =
+        s.adapter.announceVectorQuantity(s.meshIndex, "Velocity");
+    s.adapter.enableTimeInterpolation(s.pressureId);
+    s.adapter.enableTimeInterpolation(velocityId);
+    s.adapter.writeQuantityOnFaces(s.pressureId, {1., 1., 1., 1.});
+    s.adapter.writeVectorQuantityOnFace<dim>(velocityId, 4, Vector(1.));
+    s.adapter.writeQuantitiesToOtherSolver({s.pressureId, velocityId});
+    s.adapter.readQuantitiesFromOtherSolver({s.pressureId, velocityId});
+    check(s.adapter.getScalarQuantityOnFace(s.pressureId, 4, 0.5) == 1. &&
+              s.adapter.getVectorQuantityOnFace<dim>(velocityId, 4, 0.5) ==
+                  Vector(1.),
+          "constant in the first time window");
+
+    s.adapter.advance(1.);
+    // The buffer of a read quantity holds the data of the last read, the
+    // new data only reaches preCICE
+    s.adapter.writeQuantityOnFaces(s.pressureId, {3., 3., 3., 3.});
+    s.adapter.writeVectorQuantityOnFace<dim>(velocityId, 4,
+                                             Vector({3., 5., 1.}));
+    s.adapter.writeQuantitiesToOtherSolver({s.pressureId, velocityId});
+    s.adapter.writeQuantityOnFaces(s.pressureId, {1., 1., 1., 1.});
+    s.adapter.writeVectorQuantityOnFace<dim>(velocityId, 4, Vector(1.));
+    s.adapter.readQuantitiesFromOtherSolver({s.pressureId, velocityId});
+    check(s.adapter.getScalarQuantityOnFace(s.pressureId, 4, 0.) == 1. &&
+              s.adapter.getScalarQuantityOnFace(s.pressureId, 4, 0.5) == 2. &&
+              s.adapter.getScalarQuantityOnFace(s.pressureId, 4, 1.) == 3.,
+          "linear scalar in the second time window");
+    check(s.adapter.getVectorQuantityOnFace<dim>(velocityId, 4, 0.) ==
+                  Vector(1.) &&
+              s.adapter.getVectorQuantityOnFace<dim>(velocityId, 4, 0.5) ==
+                  Vector({2., 3., 1.}) &&
+              s.adapter.getVectorQuantityOnFace<dim>(velocityId, 4, 1.) ==
+                  Vector({3., 5., 1.}),
+          "linear vector in the second time window");
+}
+
+void testSnapshot()
+{
+    const std::string fileName = "test_couplingadapter-snapshot";
+    for (int window = 1; window <= 3; ++window)
+        std::remove((fileName + "." + std::to_string(window)).c_str());
+    {
+        Setup s;
+        s.adapter.enableSnapshots(fileName, 1);
+        s.adapter.writeQuantityOnFaces(s.pressureId, {1., 2., 3., 4.});
+        check(!s.adapter.hasToWriteSnapshot(), "no snapshot at the start");
+        for (int window = 1; window <= 3; ++window) {
+            s.adapter.advance(0.5);
+            check(s.adapter.hasToWriteSnapshot(), "snapshot due");
+            s.adapter.writeSnapshot({double(window), 42.});
+        }
+        s.adapter.finalize();
+        // Only the last two snapshots are kept
+        check(!std::ifstream(fileName + ".1") && std::ifstream(fileName + ".2"),
+              "snapshots kept");
+    }
+
+    Setup s;
+    s.adapter.enableSnapshots(fileName, 1);
+    std::vector<double> solverState;
+    s.adapter.readSnapshot(solverState, 2);
+    check(solverState == std::vector<double>({2., 42.}), "solver state");
+    check(s.adapter.getTime() == 1., "time");
+    check(s.adapter.getScalarQuantityOnFace(s.pressureId, 8) == 3.,
+          "quantity buffers");
+
+    bool threw = false;
+    try {
+        s.adapter.readSnapshot(solverState, 1);
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    check(threw, "missing snapshot");
+
+    Setup other;
+    other.adapter.announceScalarQuantity(other.meshIndex, "Velocity");
+    other.adapter.enableSnapshots(fileName, 1);
+    threw = false;
+    try {
+        other.adapter.readSnapshot(solverState, 3);
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    check(threw, "snapshot of other quantities");
+}
+
+void testMemoryUsage()
+{
+    CouplingAdapter adapter;
+    adapter.announceSolver("Test", "precice-config.xml", 0, 1);
+    auto coordinates =
+        pointsOnLine(adapter.getDimensions(), {3., 0., 2., 1.});
+    const auto meshIndex = adapter.setMesh("TestMesh", 4, coordinates,
+                                           VertexOrdering::Morton);
+    adapter.createIndexMapping(meshIndex, {30, 0, 20, 10});
+    adapter.initialize();
+    const auto pressureId =
+        adapter.announceScalarQuantity(meshIndex, "Pressure");
+    adapter.enableChangeTracking(pressureId);
+    auto usage = adapter.getMemoryUsage();
+    check(usage.quantities.size() == 1 &&
+              usage.quantities[0].name == "Pressure on TestMesh",
+          "quantities");
+    // The buffer and the data of the previous read
+    check(usage.quantities[0].bytes >= 2 * 4 * sizeof(double),
+          "memory of a quantity");
+    std::size_t total = usage.quantities[0].bytes;
+    for (const auto &entry : usage.structures)
+        total += entry.bytes;
+    check(usage.total() == total, "total memory");
+
+    std::ostringstream report;
+    adapter.printMemoryUsage(report);
+    check(report.str().find("total: " + std::to_string(total) + " bytes") !=
+              std::string::npos,
+          "printed memory");
+
+    // The input order of the reordered points is only needed to create the
+    // index mapping
+    adapter.releaseSetupData();
+    usage = adapter.getMemoryUsage();
+    check(usage.total() < total, "memory after release");
+    adapter.writeScalarQuantityOnFace(pressureId, 20, 2.);
+    check(adapter.getScalarQuantityOnFace(pressureId, 20) == 2.,
+          "index mapping after release");
+}
+
+void testInterfaceResidual()
+{
+    const std::string logFileName = "test_couplingadapter-residuals.log";
+    Setup s;
+    s.adapter.enableChangeTracking(s.pressureId);
+    s.adapter.enableResidualLog(logFileName);
+    s.adapter.writeQuantityOnFaces(s.pressureId, {1., 1., 1., 1.});
+    s.adapter.writeQuantityToOtherSolver(s.pressureId, QuantityType::Scalar);
+
+    const double inf = std::numeric_limits<double>::infinity();
+    s.adapter.readQuantityFromOtherSolver(s.pressureId, QuantityType::Scalar);
+    check(s.adapter.getInterfaceResidual() == inf, "first read");
+    check(s.adapter.getInexactSolverTolerance(1e-8, 1e-2, 0.1) == 1e-2,
+          "maximum tolerance without residual");
+
+    // The data did not change since the first read
+    s.adapter.readQuantityFromOtherSolver(s.pressureId, QuantityType::Scalar);
+    check(s.adapter.getInterfaceResidual() == 0., "second read");
+    check(s.adapter.getInexactSolverTolerance(1e-8, 1e-2, 0.1) == 1e-8,
+          "tolerance of a converged interface");
+
+    // The stand-in completes every time window, the next read starts anew
+    s.adapter.advance(1.);
+    check(s.adapter.getWindowResiduals().empty(), "residuals of a new window");
+    s.adapter.readQuantityFromOtherSolver(s.pressureId, QuantityType::Scalar);
+    check(s.adapter.getInterfaceResidual() == inf,
+          "first read of a new time window");
+
+    // One line per completed coupling iteration after the header
+    std::ifstream log(logFileName);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(log, line);)
+        lines.push_back(line);
+    check(lines.size() == 2 && lines[1].rfind("0 1 0 ", 0) == 0,
+          "residual log");
+}
+}  // namespace
+
+int main()
+{
+    try {
+        testIndexMapping();
+        testBulkIO();
+        testBoundBuffer();
+        testVectorQuantity();
+        testMultipleMeshes();
+        testChangeTracking();
+        testMortonOrdering();
+        testDeduplication();
+        testQuantityHandles();
+        testBatchedIO();
+        testTimeInterpolation();
+        testSnapshot();
+        testMemoryUsage();
+        testInterfaceResidual();
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
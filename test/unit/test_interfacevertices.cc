@@ -0,0 +1,202 @@
+/*!
+ * @brief Unit tests of the interface cache and the memory accounting of
+ *        InterfaceVertices.
+ *
+ * The grid geometry is a stand-in with the interface InterfaceVertices
+ * uses: a row of elements with four faces each, of which the first one is
+ * on the coupling interface. Moving the faces changes the grid without
+ * changing its sizes or its bounding box.
+ */
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <dune/grid/common/partitionset.hh>
+
+#include "dumux-precice/interfacevertices.hh"
+
+namespace
+{
+/*!
+ * @brief Throws if a condition of a test does not hold.
+ *
+ * @param[in] condition The condition.
+ * @param[in] message Description of the condition.
+ */
+void check(const bool condition, const std::string &message)
+{
+    if (!condition)
+        throw std::runtime_error("Check failed: " + message);
+}
+
+//! Communication of a sequential run.
+struct Communication {
+    int rank() const { return 0; }
+    int size() const { return 1; }
+    template<class T>
+    T max(const T &value) const
+    {
+        return value;
+    }
+    template<class T>
+    void gather(const T *in, T *out, int len, int) const
+    {
+        std::copy(in, in + len, out);
+    }
+};
+
+struct Element {
+    std::size_t index;
+};
+
+struct LineGridView {
+    static constexpr int dimension = 2;
+    static constexpr int dimensionworld = 2;
+    std::size_t numElements;
+    int size(const int codim) const
+    {
+        return codim == 0 ? int(numElements) : int(numElements + 1);
+    }
+    Communication comm() const { return {}; }
+};
+
+template<unsigned int partitions>
+std::vector<Element> elements(const LineGridView &gridView,
+                              Dune::PartitionSet<partitions>)
+{
+    std::vector<Element> result;
+    for (std::size_t e = 0; e < gridView.numElements; ++e)
+        result.push_back({e});
+    return result;
+}
+
+struct Scvf {
+    std::size_t idx;
+    std::array<double, 2> position;
+    std::size_t index() const { return idx; }
+    std::array<double, 2> center() const { return position; }
+};
+
+struct ElementMapper {
+    std::size_t index(const Element &element) const { return element.index; }
+};
+
+struct GridGeometry;
+
+struct FVElementGeometry {
+    const GridGeometry *gridGeometry;
+    std::size_t element = 0;
+    void bindElement(const Element &e) { element = e.index; }
+};
+
+//! Row of unit elements, the interface faces are moved by shift.
+struct GridGeometry {
+    using GridView = LineGridView;
+    std::size_t numElements = 4;
+    double shift = 0.;
+    GridView gridView() const { return {numElements}; }
+    ElementMapper elementMapper() const { return {}; }
+    Element element(const std::size_t index) const { return {index}; }
+    std::size_t numScvf() const { return 4 * numElements; }
+    std::array<double, 2> bBoxMin() const { return {0., 0.}; }
+    std::array<double, 2> bBoxMax() const { return {double(numElements), 1.}; }
+};
+
+FVElementGeometry localView(const GridGeometry &gridGeometry)
+{
+    return {&gridGeometry};
+}
+
+std::vector<Scvf> scvfs(const FVElementGeometry &fvGeometry)
+{
+    const double x = double(fvGeometry.element);
+    const double shift = fvGeometry.gridGeometry->shift;
+    const std::size_t first = 4 * fvGeometry.element;
+    return {{first, {x + 0.5 + shift, 0.}},
+            {first + 1, {x + 1., 0.5}},
+            {first + 2, {x + 0.5, 1.}},
+            {first + 3, {x, 0.5}}};
+}
+
+using InterfaceVertices = Dumux::Precice::InterfaceVertices<GridGeometry>;
+
+const auto isOnInterface = [](const Scvf &scvf) {
+    return scvf.center()[1] == 0.;
+};
+
+void testCache()
+{
+    const std::string fileName = "test_interfacevertices-cache";
+    std::remove(fileName.c_str());
+
+    GridGeometry gridGeometry;
+    InterfaceVertices collected;
+    check(!collected.update(gridGeometry, isOnInterface, fileName, "key"),
+          "no cache file");
+    check(collected.size() == 4, "interface faces");
+
+    InterfaceVertices cached;
+    check(cached.update(gridGeometry, isOnInterface, fileName, "key"),
+          "read from the cache file");
+    check(cached.coordinates() == collected.coordinates() &&
+              cached.faceIDs() == collected.faceIDs() &&
+              cached.elementIndices() == collected.elementIndices() &&
+              cached.elementFaceOffsets() == collected.elementFaceOffsets(),
+          "cached interface");
+
+    check(!cached.update(gridGeometry, isOnInterface, fileName, "other key"),
+          "cache of another key");
+    check(cached.update(gridGeometry, isOnInterface, fileName, "other key"),
+          "cache rewritten for the other key");
+
+    // Same sizes and bounding box, other face positions
+    GridGeometry moved;
+    moved.shift = 0.25;
+    InterfaceVertices stale;
+    check(!stale.update(moved, isOnInterface, fileName, "other key"),
+          "stale cache");
+    check(stale.coordinates()[0] == 0.75, "interface of the moved grid");
+
+    InterfaceVertices uncached;
+    check(!uncached.update(gridGeometry, isOnInterface, "", "key") &&
+              uncached.size() == 4,
+          "no cache");
+}
+
+void testMemoryUsage()
+{
+    GridGeometry gridGeometry;
+    InterfaceVertices interfaceVertices;
+    interfaceVertices.update(gridGeometry, isOnInterface);
+    const auto bytes = interfaceVertices.getMemoryUsage();
+    check(bytes > 0, "memory of the vertices");
+    std::ostringstream report;
+    interfaceVertices.reportLoad(gridGeometry.gridView().comm(), report);
+    check(report.str().find("at most " + std::to_string(bytes) + " bytes") !=
+              std::string::npos,
+          "memory in the load report");
+    interfaceVertices.release();
+    check(interfaceVertices.size() == 0 &&
+              interfaceVertices.getMemoryUsage() <= sizeof(std::size_t),
+          "memory after release");
+}
+}  // namespace
+
+int main()
+{
+    try {
+        testCache();
+        testMemoryUsage();
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}